@@ -0,0 +1,108 @@
+// Micro-benchmark comparing the array heap with the pairing heap.
+// Build with "make bench" and run ./bench/heap_bench [tasks]
+#include "priority_queue.h"
+#include "pairing_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+static Task makeTask(long i) {
+    Task task = {0};
+    task.id = (int)i + 1;
+    task.priority = rand() % 1000;
+    task.executionTime = 1;
+    task.seq = i;
+    task.heapIndex = -1;
+    return task;
+}
+
+static void report(const char* what, double arraySeconds, double pairingSeconds, long n) {
+    printf("  %-28s %10.1f ns %10.1f ns\n", what,
+           arraySeconds * 1e9 / n, pairingSeconds * 1e9 / n);
+}
+
+int main(int argc, char* argv[]) {
+    long n = argc > 1 ? atol(argv[1]) : 1000000;
+    if (n < 2) n = 2;
+    long half = n / 2;
+    double start, arrayInsert, pairingInsert, arrayExtract, pairingExtract;
+    double arrayCombine, pairingCombine;
+
+    printf("  %-28s %13s %13s\n", "per task", "array", "pairing");
+
+    // Insert n tasks, then drain them in priority order
+    PriorityQueue pq;
+    initPriorityQueue(&pq, 10);
+    srand(1);
+    start = nowSeconds();
+    for (long i = 0; i < n; i++) insertPQ(&pq, makeTask(i));
+    arrayInsert = nowSeconds() - start;
+    start = nowSeconds();
+    while (!isPQEmpty(&pq)) extractMax(&pq);
+    arrayExtract = nowSeconds() - start;
+
+    PairingHeap ph;
+    initPairingHeap(&ph);
+    srand(1);
+    start = nowSeconds();
+    for (long i = 0; i < n; i++) insertPairing(&ph, makeTask(i));
+    pairingInsert = nowSeconds() - start;
+    start = nowSeconds();
+    while (!isPairingEmpty(&ph)) extractMaxPairing(&ph);
+    pairingExtract = nowSeconds() - start;
+
+    report("insert", arrayInsert, pairingInsert, n);
+    report("extract max", arrayExtract, pairingExtract, n);
+
+    // Combine two half-size backlogs: the array heap has to move every task
+    // of one into the other, the pairing heap links the two roots
+    PriorityQueue other;
+    initPriorityQueue(&other, 10);
+    srand(2);
+    for (long i = 0; i < half; i++) {
+        insertPQ(&pq, makeTask(i));
+        insertPQ(&other, makeTask(half + i));
+    }
+    start = nowSeconds();
+    while (!isPQEmpty(&other)) insertPQ(&pq, extractMax(&other));
+    arrayCombine = nowSeconds() - start;
+
+    PairingHeap backlog;
+    initPairingHeap(&backlog);
+    srand(2);
+    for (long i = 0; i < half; i++) {
+        insertPairing(&ph, makeTask(i));
+        insertPairing(&backlog, makeTask(half + i));
+    }
+    start = nowSeconds();
+    meldPQ(&ph, &backlog);
+    pairingCombine = nowSeconds() - start;
+
+    report("combine two backlogs", arrayCombine, pairingCombine, half);
+    if (pq.size != ph.size) {
+        fprintf(stderr, "  Error: Sizes differ after combining (%d vs %d)\n", pq.size, ph.size);
+        return 1;
+    }
+
+    // Both heaps must agree on the order they hand tasks out in
+    long mismatches = 0;
+    while (!isPQEmpty(&pq)) {
+        if (extractMax(&pq).priority != extractMaxPairing(&ph).priority) mismatches++;
+    }
+    if (mismatches > 0) {
+        fprintf(stderr, "  Error: %ld tasks extracted out of order\n", mismatches);
+        return 1;
+    }
+
+    freePQ(&pq);
+    freePQ(&other);
+    freePairingHeap(&ph);
+    freePairingHeap(&backlog);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#ifndef COROUTINE_H
+#define COROUTINE_H
+
+// Stackful cooperative coroutines for tasks that run real code.
+// Stacks come from a process-wide pool; each has a PROT_NONE guard page
+// below it, so an overflow faults instead of corrupting a neighbour.
+// Every guard page costs two kernel mappings, so only the first
+// vm.max_map_count / 4 stacks are guarded; later ones are handed out
+// without a guard rather than failing.
+
+#define COROUTINE_STACK_SIZE (32 * 1024)
+
+typedef void (*CoroutineFn)(void* arg);
+typedef struct Coroutine Coroutine;
+
+// Function declarations
+Coroutine* createCoroutine(CoroutineFn fn, void* arg);
+int resumeCoroutine(Coroutine* co);
+void yieldCoroutine(void);
+void destroyCoroutine(Coroutine* co);
+void releaseCoroutinePool(void);
+
+#endif // COROUTINE_H
@@ -0,0 +1,54 @@
+#ifndef DAEMON_H
+#define DAEMON_H
+
+#include "scheduler.h"
+#include "sharded_scheduler.h"
+
+// Line protocol spoken on the daemon socket (one command per line):
+//   SUBMIT <priority> <execTime> <name>   -> OK <id> | ERR rejected
+//     (under ADMIT_BLOCK a full queue parks the client until there is room)
+//   TSUBMIT <tenant> <priority> <execTime> <name> -> as SUBMIT, owned by tenant
+//   CSUBMIT <priority> <steps> <name>     -> OK <id> | ERR rejected | ERR nostack
+//     (a coroutine task that yields once per step; RUN drives it to the end)
+//   WEIGHT <tenant> <weight>              -> OK <tenant>
+//   SHARE <tenant>                        -> OK weight=.. queued=.. dispatched=..
+//                                            service=.. share=<%> target=<%>
+//   CANCEL <id>                           -> OK <id> | ERR notfound
+//   PURGE NAME <prefix>                   -> OK <tasks cancelled>
+//   PURGE PRIORITY|ID <low> <high>        -> OK <tasks cancelled>
+//   PAUSE <id>                            -> OK <id> | ERR notfound
+//     (takes a queued task off the queue and holds it in history as PAUSED)
+//   RESUME <id>                           -> OK <id> | ERR notpaused | ERR notfound
+//     (queues a task held by PAUSE or loaded as PAUSED by IMPORT; each pause
+//      can be resumed once and a queued task answers notpaused)
+//   REPRIORITIZE <id> <priority>          -> OK <id> | ERR notfound
+//     (queued tasks only; raising one under --heap pairing is O(1))
+//   RUN [count]                           -> OK <tasks completed>
+//   RANK <id>                             -> OK <rank by priority, then arrival> | ERR notfound
+//     (the priority-order rank in every mode, not the FIFO or FAIR_SHARE dispatch position)
+//   ABOVE <priority>                      -> OK <count>
+//   RANGE <low> <high>                    -> OK <count> <id>...
+//   IMPORT <file>                         -> OK <tasks loaded> | ERR ...
+//     (queued records stop loading once the queue reaches --capacity, or the
+//      high watermark if set, answering ERR full after <tasks loaded>)
+//   EXPORT BINARY|CSV <file>              -> OK <tasks written> | ERR ...
+//     (<file> is a plain name inside the --data-dir directory; without one
+//      both answer ERR no data directory)
+//   STATS                                 -> STATS key=value ...
+//   QUIT                                  -> connection closed
+// With --shards N the daemon fronts N schedulers whose workers run tasks on
+// their own; it accepts SUBMIT, CANCEL, PAUSE, RESUME, STATS (adds shards=N),
+// QUIT and
+//   LIST                                  -> OK <count> <id>...
+//     (every queued task of all shards, highest priority first)
+// and answers ERR unsupported with shards to everything else. PAUSE only
+// finds tasks a worker has not picked up yet, and RESUME answers
+// ERR notfound for anything that is not paused.
+// Clients may pipeline any number of commands; replies come back in order
+// and are flushed in batches once all buffered input has been processed.
+
+// Function declarations
+int runDaemon(TaskScheduler* scheduler, const char* socketPath, const char* dataDir);
+int runShardedDaemon(ShardedScheduler* ss, const char* socketPath);
+
+#endif // DAEMON_H
@@ -0,0 +1,53 @@
+#ifndef FAIR_QUEUE_H
+#define FAIR_QUEUE_H
+
+#include "task.h"
+#include "queue.h"
+
+#define DEFAULT_TENANT 0
+#define DEFAULT_TENANT_WEIGHT 1
+#define VRUNTIME_SCALE 1024   // Virtual runtime charged per second of work at weight 1
+
+// One tenant's ready queue and its share accounting
+typedef struct Tenant {
+    int id;
+    int weight;
+    long vruntime;            // Weighted service received, in VRUNTIME_SCALE units
+    TaskQueue queue;
+    int heapIndex;            // Slot in the active-tenant heap, -1 while idle
+    long dispatched;          // Tasks handed out
+    long serviceTime;         // Sum of their execution times
+    struct Tenant* hashNext;  // Chain in the tenant lookup table
+} Tenant;
+
+// Weighted fair queue: a FIFO per tenant and a min-heap of tenants with
+// queued work ordered by virtual runtime (stride / CFS style)
+typedef struct {
+    Tenant** buckets;
+    int bucketCount;
+    int tenantCount;
+    Tenant** active;          // Min-heap by (vruntime, id)
+    int activeCount;
+    int activeCapacity;
+    long minVruntime;         // Floor given to tenants that become active again
+    long totalService;
+    long totalWeight;
+    int size;                 // Queued tasks across all tenants
+} FairQueue;
+
+// Function declarations
+void initFairQueue(FairQueue* fq);
+Tenant* findTenant(const FairQueue* fq, int id);
+Tenant* getTenant(FairQueue* fq, int id);
+void setTenantWeight(FairQueue* fq, int id, int weight);
+QueueNode* enqueueFair(FairQueue* fq, Task task);
+Task dequeueFair(FairQueue* fq);
+int isFairEmpty(const FairQueue* fq);
+void removeNodeFromFair(FairQueue* fq, QueueNode* node, Task* removed);
+int removeWhereFromFair(FairQueue* fq, TaskPredicate predicate, const void* ctx,
+                        TaskVisitor onRemoved, void* visitorCtx);
+void displayFairQueue(const FairQueue* fq);
+void displayTenantShares(const FairQueue* fq);
+void freeFairQueue(FairQueue* fq);
+
+#endif // FAIR_QUEUE_H
@@ -0,0 +1,97 @@
+#ifndef HEAP_TEMPLATE_H
+#define HEAP_TEMPLATE_H
+
+// Type-generic binary heap over a plain array, generated per element type.
+//
+//   #define TASK_BEFORE(a, b) ((a)->priority > (b)->priority)
+//   DEFINE_HEAP(taskHeap, Task*, TASK_BEFORE)
+//
+// expands to static inline taskHeapSiftUp/SiftDown/Push/PopRoot/RemoveAt/Build.
+// BEFORE(a, b) must be true when a belongs nearer the root than b; it is
+// expanded in place, so no function pointer is called per comparison.
+// The caller owns the array and guarantees room for one more element on Push.
+//
+// DEFINE_TRACKED_HEAP additionally expands MOVED(item, index) every time an
+// element is stored at a new index, so elements can record their position
+// and be removed later in O(log n).
+
+#define HEAP_NOT_TRACKED(item, index) ((void)0)
+
+#define DEFINE_HEAP(NAME, TYPE, BEFORE) \
+    DEFINE_TRACKED_HEAP(NAME, TYPE, BEFORE, HEAP_NOT_TRACKED)
+
+#define DEFINE_TRACKED_HEAP(NAME, TYPE, BEFORE, MOVED)                          \
+                                                                                \
+/* Move heap[index] towards the root - Time Complexity: O(log n) */             \
+static inline void NAME##SiftUp(TYPE* heap, int index) {                        \
+    TYPE item = heap[index];                                                    \
+    while (index > 0) {                                                         \
+        int up = (index - 1) / 2;                                               \
+        if (!(BEFORE(item, heap[up]))) break;                                   \
+        heap[index] = heap[up];                                                 \
+        MOVED(heap[index], index);                                              \
+        index = up;                                                             \
+    }                                                                           \
+    heap[index] = item;                                                         \
+    MOVED(item, index);                                                         \
+}                                                                               \
+                                                                                \
+/* Move heap[index] towards the leaves - Time Complexity: O(log n) */           \
+static inline void NAME##SiftDown(TYPE* heap, int size, int index) {            \
+    TYPE item = heap[index];                                                    \
+    for (;;) {                                                                  \
+        int child = 2 * index + 1;                                              \
+        if (child >= size) break;                                               \
+        if (child + 1 < size && (BEFORE(heap[child + 1], heap[child]))) {       \
+            child++;                                                            \
+        }                                                                       \
+        if (!(BEFORE(heap[child], item))) break;                                \
+        heap[index] = heap[child];                                              \
+        MOVED(heap[index], index);                                              \
+        index = child;                                                          \
+    }                                                                           \
+    heap[index] = item;                                                         \
+    MOVED(item, index);                                                         \
+}                                                                               \
+                                                                                \
+/* Append an element and restore order - Time Complexity: O(log n) */           \
+static inline void NAME##Push(TYPE* heap, int* size, TYPE item) {               \
+    heap[*size] = item;                                                         \
+    NAME##SiftUp(heap, *size);                                                  \
+    (*size)++;                                                                  \
+}                                                                               \
+                                                                                \
+/* Remove and return the root; size must be > 0 - Time Complexity: O(log n) */  \
+static inline TYPE NAME##PopRoot(TYPE* heap, int* size) {                       \
+    TYPE root = heap[0];                                                        \
+    (*size)--;                                                                  \
+    if (*size > 0) {                                                            \
+        heap[0] = heap[*size];                                                  \
+        NAME##SiftDown(heap, *size, 0);                                         \
+    }                                                                           \
+    return root;                                                                \
+}                                                                               \
+                                                                                \
+/* Remove the element at index - Time Complexity: O(log n) */                   \
+static inline TYPE NAME##RemoveAt(TYPE* heap, int* size, int index) {          \
+    TYPE removed = heap[index];                                                 \
+    (*size)--;                                                                  \
+    if (index < *size) {                                                        \
+        heap[index] = heap[*size];                                              \
+        NAME##SiftDown(heap, *size, index);                                     \
+        NAME##SiftUp(heap, index);                                              \
+    }                                                                           \
+    return removed;                                                             \
+}                                                                               \
+                                                                                \
+/* Bottom-up heap construction of an unordered array - Time Complexity: O(n) */ \
+static inline void NAME##Build(TYPE* heap, int size) {                          \
+    for (int i = size / 2; i < size; i++) {                                     \
+        MOVED(heap[i], i);  /* Leaves are never sifted */                       \
+    }                                                                           \
+    for (int i = size / 2 - 1; i >= 0; i--) {                                   \
+        NAME##SiftDown(heap, size, i);                                          \
+    }                                                                           \
+}
+
+#endif // HEAP_TEMPLATE_H
@@ -14,6 +14,7 @@ typedef struct {
     HistoryNode* head;
     HistoryNode* tail;
     int count;
+    int limit;    // Finished records kept, oldest dropped first; 0 keeps all
 } TaskHistory;
 
 // Function declarations
@@ -0,0 +1,56 @@
+#ifndef ORDER_INDEX_H
+#define ORDER_INDEX_H
+
+#include "task.h"
+
+#define INDEX_MAX_LEVEL 32
+
+struct IndexNode;
+
+// Forward link with the number of level-0 steps it skips
+typedef struct {
+    struct IndexNode* next;
+    int span;
+} IndexLink;
+
+// Skip list node keeping only the ordering key; the rest of the task is read
+// through task, which points at the entry inside the structure queuing it
+typedef struct IndexNode {
+    int id;
+    int priority;
+    long seq;
+    Task* task;                   // Queued entry, owned by its ready structure
+    struct IndexNode* hashNext;   // Chain in the ID lookup table
+    int level;
+    IndexLink links[];
+} IndexNode;
+
+// Order-statistic index of queued tasks: a span-augmented skip list ordered
+// by (priority descending, arrival seq ascending) plus an ID hash table
+typedef struct {
+    IndexNode* head;
+    IndexNode* tail;
+    int level;
+    int count;
+    IndexNode** buckets;
+    int bucketCount;
+    unsigned int rng;
+    IndexNode** staged;    // Bulk entries waiting for mergeStagedIndex
+    int stagedCount;
+    int stagedCapacity;
+} OrderIndex;
+
+// Function declarations
+void initOrderIndex(OrderIndex* index);
+void insertIndex(OrderIndex* index, Task* task);
+void stageIndex(OrderIndex* index, Task* task);
+void mergeStagedIndex(OrderIndex* index);
+int removeFromIndex(OrderIndex* index, const Task* task);
+IndexNode* findInIndex(const OrderIndex* index, int id);
+int countAbovePriority(const OrderIndex* index, int priority);
+int countPriorityRange(const OrderIndex* index, int low, int high);
+int rankInIndex(const OrderIndex* index, int id);
+int listPriorityRange(const OrderIndex* index, int low, int high, Task* out, int maxOut);
+void freeOrderIndex(OrderIndex* index);
+
+#endif // ORDER_INDEX_H
@@ -0,0 +1,47 @@
+#ifndef PAIRING_HEAP_H
+#define PAIRING_HEAP_H
+
+#include "task.h"
+
+// Heap node; also serves as the caller's handle for increaseKeyPairing and
+// removeNodeFromPairing. The scheduler's heaps are mirrored in its order index,
+// so their priorities change only through reprioritizeTask.
+typedef struct PairingNode {
+    Task task;
+    struct PairingNode* child;
+    struct PairingNode* sibling;
+    struct PairingNode* prev;    // Parent if leftmost child, else left sibling
+} PairingNode;
+
+// Block of pooled nodes
+typedef struct PairingChunk {
+    struct PairingChunk* next;
+    int count;
+    PairingNode nodes[];
+} PairingChunk;
+
+// Mergeable priority queue: max pairing heap over pooled nodes
+typedef struct {
+    PairingNode* root;
+    int size;
+    PairingNode* freeHead;       // Unused pool nodes
+    PairingNode* freeTail;
+    PairingChunk* chunks;
+    PairingChunk* lastChunk;
+    int nextChunkSize;
+} PairingHeap;
+
+// Function declarations
+void initPairingHeap(PairingHeap* ph);
+PairingNode* insertPairing(PairingHeap* ph, Task task);
+Task extractMaxPairing(PairingHeap* ph);
+int increaseKeyPairing(PairingHeap* ph, PairingNode* node, int newPriority);
+void removeNodeFromPairing(PairingHeap* ph, PairingNode* node, Task* removed);
+int removeWhereFromPairing(PairingHeap* ph, TaskPredicate predicate, const void* ctx,
+                           TaskVisitor onRemoved, void* visitorCtx);
+void meldPQ(PairingHeap* dst, PairingHeap* src);
+int isPairingEmpty(const PairingHeap* ph);
+void displayPairingHeap(const PairingHeap* ph);
+void freePairingHeap(PairingHeap* ph);
+
+#endif // PAIRING_HEAP_H
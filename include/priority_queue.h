@@ -12,11 +12,15 @@ typedef struct {
 
 // Function declarations
 void initPriorityQueue(PriorityQueue* pq, int capacity);
-void insertPQ(PriorityQueue* pq, Task task);
+Task* insertPQ(PriorityQueue* pq, Task task);
+Task* appendPQ(PriorityQueue* pq, Task task);
+void heapifyPQ(PriorityQueue* pq);
 Task extractMax(PriorityQueue* pq);
 int isPQEmpty(const PriorityQueue* pq);
 void displayPQ(const PriorityQueue* pq);
-int removeFromPQ(PriorityQueue* pq, int id);
+void removeEntryFromPQ(PriorityQueue* pq, Task* entry, Task* removed);
+int removeWhereFromPQ(PriorityQueue* pq, TaskPredicate predicate, const void* ctx,
+                      TaskVisitor onRemoved, void* visitorCtx);
 void freePQ(PriorityQueue* pq);
 
 #endif // PRIORITY_QUEUE_H
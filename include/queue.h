@@ -7,6 +7,7 @@
 typedef struct QueueNode {
     Task task;
     struct QueueNode* next;
+    struct QueueNode* prev;
 } QueueNode;
 
 // Queue structure
@@ -18,11 +19,13 @@ typedef struct {
 
 // Function declarations
 void initQueue(TaskQueue* queue);
-void enqueue(TaskQueue* queue, Task task);
+QueueNode* enqueue(TaskQueue* queue, Task task);
 Task dequeue(TaskQueue* queue);
 int isQueueEmpty(const TaskQueue* queue);
 void displayQueue(const TaskQueue* queue);
-int removeFromQueue(TaskQueue* queue, int id);
+void removeNodeFromQueue(TaskQueue* queue, QueueNode* node, Task* removed);
+int removeWhereFromQueue(TaskQueue* queue, TaskPredicate predicate, const void* ctx,
+                         TaskVisitor onRemoved, void* visitorCtx);
 void freeQueue(TaskQueue* queue);
 
 #endif // QUEUE_H
@@ -4,27 +4,122 @@
 #include "task.h"
 #include "queue.h"
 #include "priority_queue.h"
+#include "pairing_heap.h"
+#include "fair_queue.h"
 #include "linked_list.h"
+#include "coroutine.h"
+#include "order_index.h"
+
+// Submit results other than a task ID
+#define SUBMIT_REJECTED -1      // Refused or shed by admission control
+#define SUBMIT_WOULD_BLOCK -2   // Queue full under ADMIT_BLOCK; retry once work drains
+
+// Heap behind PRIORITY mode
+typedef enum {
+    HEAP_ARRAY,      // Binary heap of task pointers
+    HEAP_PAIRING     // Pooled pairing heap; bulk loads are melded in whole
+} PriorityBackend;
+
+// What submit does when the queue is at capacity
+typedef enum {
+    ADMIT_REJECT,
+    ADMIT_BLOCK,
+    ADMIT_EVICT_LOWEST
+} OverloadPolicy;
+
+// Admission limits on queued tasks; zero disables a limit
+typedef struct {
+    int capacity;         // Hard limit handled by policy
+    int highWatermark;    // Start shedding low-priority submissions here...
+    int lowWatermark;     // ...and stop once the queue drains to here
+    OverloadPolicy policy;
+} AdmissionConfig;
+
+// Running totals kept by the scheduler
+typedef struct {
+    long submitted;
+    long completed;
+    long cancelled;
+    long resumed;
+    long rejected;        // Refused at capacity
+    long blocked;         // Submissions held back at capacity (once each)
+    long evicted;         // Lowest-priority tasks dropped to make room
+    long shed;            // Refused between the watermarks
+} SchedulerStats;
+
+// Built-in filters for bulk cancellation
+typedef enum {
+    FILTER_NAME_PREFIX,
+    FILTER_PRIORITY_RANGE,
+    FILTER_ID_RANGE
+} TaskFilterKind;
+
+typedef struct {
+    TaskFilterKind kind;
+    const char* prefix;  // FILTER_NAME_PREFIX
+    int low;             // Inclusive bounds for the range filters
+    int high;
+} TaskFilter;
 
 // Global state for task scheduler
 typedef struct {
     TaskQueue readyQueue;
     PriorityQueue priorityQueue;
+    PairingHeap pairingQueue;     // Used instead of priorityQueue with HEAP_PAIRING
+    PairingHeap pairingBacklog;   // Bulk-loaded tasks until finishBulkLoad melds them
+    PriorityBackend priorityBackend;
+    FairQueue fairQueue;   // Per-tenant ready queues for FAIR_SHARE mode
     TaskHistory history;
     SchedulingMode mode;
     int nextTaskId;
     Task* runningTask;
+    SchedulerStats stats;
+    OrderIndex index;      // Every queued task, for rank and range queries
+    long nextSeq;
+    AdmissionConfig admission;
+    int shedding;          // Set between crossing the high and low watermarks
 } TaskScheduler;
 
-// Function declarations
+// Non-interactive operations (used by the menu and the daemon)
+void configureAdmission(TaskScheduler* scheduler, AdmissionConfig config);
+int setPriorityBackend(TaskScheduler* scheduler, PriorityBackend backend);
+int admitTask(TaskScheduler* scheduler, int priority);
+void reserveTaskId(TaskScheduler* scheduler, int id);
+void enqueueTask(TaskScheduler* scheduler, Task task);
+void bulkLoadTask(TaskScheduler* scheduler, Task task);
+void finishBulkLoad(TaskScheduler* scheduler);
+int submitTask(TaskScheduler* scheduler, const char* name, int priority, int execTime);
+int submitTenantTask(TaskScheduler* scheduler, int tenant, const char* name, int priority,
+                     int execTime);
+int submitCoroutineTask(TaskScheduler* scheduler, const char* name, int priority, int execTime,
+                        CoroutineFn fn, void* arg);
+int submitSteppedTask(TaskScheduler* scheduler, const char* name, int priority, int steps);
+int dequeueNextTask(TaskScheduler* scheduler, Task* out);
+int takeLeastUrgentTask(TaskScheduler* scheduler, Task* out);
+int completeNextTask(TaskScheduler* scheduler, Task* out);
+int cancelTask(TaskScheduler* scheduler, int id);
+int removeWhere(TaskScheduler* scheduler, TaskPredicate predicate, const void* ctx);
+int matchTaskFilter(const Task* task, const void* filter);
+int pauseTaskById(TaskScheduler* scheduler, int id);
+int reprioritizeTask(TaskScheduler* scheduler, int id, int priority);
+int resumeTaskById(TaskScheduler* scheduler, int id);
+int queuedCount(const TaskScheduler* scheduler);
+const char* modeToString(SchedulingMode mode);
+
+// Interactive menu operations
 void initScheduler(TaskScheduler* scheduler);
 void addTask(TaskScheduler* scheduler);
+void addSteppedTask(TaskScheduler* scheduler);
 void executeNextTask(TaskScheduler* scheduler);
 void pauseTask(TaskScheduler* scheduler);
 void resumeTask(TaskScheduler* scheduler);
 void removeTask(TaskScheduler* scheduler);
 void displayAll(const TaskScheduler* scheduler);
 void switchMode(TaskScheduler* scheduler);
+void queryQueue(const TaskScheduler* scheduler);
+void bulkRemoveTasks(TaskScheduler* scheduler);
+void setTenantWeightMenu(TaskScheduler* scheduler);
+void importExportTasks(TaskScheduler* scheduler);
 void runScheduler(TaskScheduler* scheduler);
 void cleanupScheduler(TaskScheduler* scheduler);
 
@@ -0,0 +1,64 @@
+#ifndef SHARDED_SCHEDULER_H
+#define SHARDED_SCHEDULER_H
+
+#include <pthread.h>
+#include "scheduler.h"
+
+// Current shard of a task queued away from its home shard
+typedef struct ForwardEntry {
+    int id;
+    int shard;
+    struct ForwardEntry* next;
+} ForwardEntry;
+
+// Forwarding table for migrated tasks. The rebalancer updates it while holding
+// both shard locks; lock is always taken after any shard lock
+typedef struct {
+    pthread_mutex_t lock;
+    ForwardEntry** buckets;
+    int bucketCount;
+    int count;
+    int shardCount;       // A task's home shard is id % shardCount
+} ForwardTable;
+
+// One independent scheduler instance with its own lock and pinned worker
+typedef struct {
+    TaskScheduler scheduler;
+    pthread_mutex_t lock;
+    pthread_cond_t workAvailable;
+    pthread_t worker;
+    int index;
+    int core;
+    int nextLocalId;
+    int load;             // Queued task count, readable without the lock
+    int stopping;
+    long migratedIn;
+    long migratedOut;
+    ForwardTable* forward;   // Shared by every shard of the front end
+} SchedulerShard;
+
+// Front end owning N shards; task IDs encode the owning shard (id % N)
+typedef struct {
+    SchedulerShard* shards;
+    int shardCount;
+    ForwardTable forward;
+    int running;
+    int rebalanceIntervalMs;
+    pthread_t rebalancer;
+} ShardedScheduler;
+
+// Function declarations
+void initShardedScheduler(ShardedScheduler* ss, int shardCount, SchedulingMode mode);
+void configureShardAdmission(ShardedScheduler* ss, AdmissionConfig config);
+void startShardWorkers(ShardedScheduler* ss, int rebalanceIntervalMs);
+void stopShardWorkers(ShardedScheduler* ss);
+int shardedSubmit(ShardedScheduler* ss, const char* name, int priority, int execTime);
+int shardedCancel(ShardedScheduler* ss, int id);
+int shardedPause(ShardedScheduler* ss, int id);
+int shardedResume(ShardedScheduler* ss, int id);
+int rebalanceShards(ShardedScheduler* ss);
+void shardedStats(ShardedScheduler* ss, SchedulerStats* total, int* queued);
+int snapshotShardedTasks(ShardedScheduler* ss, Task** out);
+void cleanupShardedScheduler(ShardedScheduler* ss);
+
+#endif // SHARDED_SCHEDULER_H
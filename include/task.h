@@ -7,15 +7,19 @@ typedef enum {
     RUNNING,
     PAUSED,
     COMPLETED,
-    REMOVED
+    REMOVED,
+    RESUMED     // History record of a pause that has been resumed since
 } TaskStatus;
 
 // Scheduling mode definitions
 typedef enum {
     FIFO,
-    PRIORITY
+    PRIORITY,
+    FAIR_SHARE
 } SchedulingMode;
 
+struct Coroutine;
+
 // Task structure containing all task information
 typedef struct {
     int id;
@@ -23,8 +27,16 @@ typedef struct {
     int priority;        // Higher value means higher priority
     int executionTime;   // Simulated execution time in seconds
     TaskStatus status;
+    int tenant;          // Submitting tenant, for fair-share scheduling
+    long seq;            // Arrival order, assigned each time the task is queued
+    int heapIndex;       // Slot in the priority queue while queued there
+    struct Coroutine* coroutine;  // Execution state of a coroutine task, else NULL
 } Task;
 
+// Callbacks used by bulk operations on task containers
+typedef int (*TaskPredicate)(const Task* task, const void* ctx);
+typedef void (*TaskVisitor)(Task* task, void* ctx);
+
 // Function declarations
 const char* statusToString(TaskStatus status);
 Task createTask(int id, const char* name, int priority, int execTime);
@@ -0,0 +1,37 @@
+#ifndef TASK_IO_H
+#define TASK_IO_H
+
+#include "scheduler.h"
+#include <stdint.h>
+
+// Binary task set: a TaskFileHeader followed by count fixed-size TaskRecords,
+// all in host byte order
+#define TASK_FILE_MAGIC "TASKSET1"
+#define TASK_RECORD_NAME 100
+
+typedef struct {
+    char magic[8];
+    uint32_t recordSize;
+    uint32_t reserved;
+    uint64_t count;
+} TaskFileHeader;
+
+typedef struct {
+    int32_t id;
+    int32_t priority;
+    int32_t executionTime;
+    int32_t status;
+    int32_t tenant;
+    char name[TASK_RECORD_NAME];   // NUL-padded
+} TaskRecord;
+
+typedef enum {
+    TASKFILE_BINARY,
+    TASKFILE_CSV       // id,name,priority,executionTime,status,tenant
+} TaskFileFormat;
+
+// Function declarations
+long importTasks(TaskScheduler* scheduler, const char* path, long* errorLine, int* full);
+long exportTasks(const TaskScheduler* scheduler, const char* path, TaskFileFormat format);
+
+#endif // TASK_IO_H
@@ -1,10 +1,124 @@
 #include "scheduler.h"
+#include "daemon.h"
+#include "task_io.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 
-int main() {
+#define SHARD_REBALANCE_MS 100
+
+// Print command line usage
+static void printUsage(const char* program) {
+    printf("Usage: %s [options]\n", program);
+    printf("  --daemon [socket]          Serve over a UNIX socket instead of the menu\n");
+    printf("  --capacity N               Maximum number of queued tasks\n");
+    printf("  --watermarks HIGH LOW      Shed low-priority submissions between HIGH and LOW\n");
+    printf("  --policy reject|block|evict  What to do when the queue is at capacity\n");
+    printf("  --mode fifo|priority|fair  Initial scheduling mode\n");
+    printf("  --heap array|pairing       Heap behind PRIORITY mode (default array)\n");
+    printf("  --import FILE              Load a binary or CSV task set at startup\n");
+    printf("  --data-dir DIR             Directory the daemon's IMPORT/EXPORT may use\n");
+    printf("  --shards N                 Daemon runs N scheduler shards with worker threads\n");
+}
+
+int main(int argc, char* argv[]) {
     TaskScheduler scheduler;
     initScheduler(&scheduler);
     
+    const char* socketPath = NULL;
+    const char* importPath = NULL;
+    const char* dataDir = NULL;
+    int shardCount = 0;
+    PriorityBackend backend = HEAP_ARRAY;
+    AdmissionConfig admission = scheduler.admission;
+    
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--daemon") == 0) {
+            socketPath = (i + 1 < argc && argv[i + 1][0] != '-') ? argv[++i]
+                                                                : "/tmp/task_scheduler.sock";
+        } else if (strcmp(argv[i], "--capacity") == 0 && i + 1 < argc) {
+            admission.capacity = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--watermarks") == 0 && i + 2 < argc) {
+            admission.highWatermark = atoi(argv[++i]);
+            admission.lowWatermark = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--policy") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "block") == 0) {
+                admission.policy = ADMIT_BLOCK;
+            } else if (strcmp(argv[i], "evict") == 0) {
+                admission.policy = ADMIT_EVICT_LOWEST;
+            } else {
+                admission.policy = ADMIT_REJECT;
+            }
+        } else if (strcmp(argv[i], "--import") == 0 && i + 1 < argc) {
+            importPath = argv[++i];
+        } else if (strcmp(argv[i], "--heap") == 0 && i + 1 < argc) {
+            backend = strcmp(argv[++i], "pairing") == 0 ? HEAP_PAIRING : HEAP_ARRAY;
+        } else if (strcmp(argv[i], "--shards") == 0 && i + 1 < argc) {
+            shardCount = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--data-dir") == 0 && i + 1 < argc) {
+            dataDir = argv[++i];
+        } else if (strcmp(argv[i], "--mode") == 0 && i + 1 < argc) {
+            i++;
+            if (strcmp(argv[i], "priority") == 0) {
+                scheduler.mode = PRIORITY;
+            } else if (strcmp(argv[i], "fair") == 0) {
+                scheduler.mode = FAIR_SHARE;
+            } else {
+                scheduler.mode = FIFO;
+            }
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+    configureAdmission(&scheduler, admission);
+    setPriorityBackend(&scheduler, backend);
+    
+    if (shardCount > 0 && (socketPath == NULL || importPath != NULL)) {
+        fprintf(stderr, "  Error: --shards needs --daemon and cannot be combined with --import\n");
+        cleanupScheduler(&scheduler);
+        return 1;
+    }
+    
+    if (importPath != NULL) {
+        long errorLine;
+        int full;
+        long loaded = importTasks(&scheduler, importPath, &errorLine, &full);
+        if (loaded < 0) {
+            fprintf(stderr, "  Error: Could not import '%s'\n", importPath);
+            cleanupScheduler(&scheduler);
+            return 1;
+        }
+        printf("  Imported %ld task(s) from %s\n", loaded, importPath);
+        if (errorLine > 0) printf("  Warning: Stopped at malformed entry %ld.\n", errorLine);
+        if (full) printf("  Warning: Stopped once the queue reached its admission limit.\n");
+    }
+    
+    // Sharded daemon: the shards' workers run tasks as they are submitted
+    if (shardCount > 0) {
+        ShardedScheduler shards;
+        initShardedScheduler(&shards, shardCount, scheduler.mode);
+        configureShardAdmission(&shards, admission);
+        for (int i = 0; i < shardCount; i++) {
+            setPriorityBackend(&shards.shards[i].scheduler, backend);
+        }
+        startShardWorkers(&shards, SHARD_REBALANCE_MS);
+        int status = runShardedDaemon(&shards, socketPath);
+        cleanupShardedScheduler(&shards);
+        cleanupScheduler(&scheduler);
+        releaseCoroutinePool();
+        return status;
+    }
+    
+    // Daemon mode: serve the scheduler over a UNIX-domain socket
+    if (socketPath != NULL) {
+        int status = runDaemon(&scheduler, socketPath, dataDir);
+        cleanupScheduler(&scheduler);
+        releaseCoroutinePool();
+        return status;
+    }
+    
     printf("\n");
     printf("  ==================================================\n");
     printf("                                                    \n");
@@ -18,6 +132,7 @@ int main() {
     getchar();
     
     runScheduler(&scheduler);
+    releaseCoroutinePool();
     
     return 0;
 }
@@ -0,0 +1,209 @@
+#include "coroutine.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#if !defined(__x86_64__)
+#include <ucontext.h>
+#endif
+
+#define STACKS_PER_SLAB 64
+
+struct Coroutine {
+    void* sp;                  // Saved stack pointer of the coroutine
+    void* callerSp;            // Saved stack pointer of whoever resumed it
+    CoroutineFn fn;
+    void* arg;
+    int finished;
+    struct Coroutine* nextFree;
+#if !defined(__x86_64__)
+    ucontext_t context;
+    ucontext_t callerContext;
+#endif
+};
+
+// One mmap'ed block of guard-paged stacks
+typedef struct StackSlab {
+    void* base;
+    size_t length;
+    struct StackSlab* next;
+} StackSlab;
+
+static pthread_mutex_t poolLock = PTHREAD_MUTEX_INITIALIZER;
+static Coroutine* freeCoroutines = NULL;
+static StackSlab* slabs = NULL;
+static long guardBudget = -1;     // Stacks that may still get a guard page
+static __thread Coroutine* currentCoroutine = NULL;
+
+#if defined(__x86_64__)
+// Save callee-saved registers on the current stack, store its pointer in
+// *saveSp, then load loadSp and restore the registers saved there.
+void coroutineSwitch(void** saveSp, void* loadSp);
+__asm__(
+    ".text\n"
+    ".globl coroutineSwitch\n"
+    ".type coroutineSwitch, @function\n"
+    "coroutineSwitch:\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+    ".size coroutineSwitch, .-coroutineSwitch\n");
+#endif
+
+// First frame of every coroutine: run the body, then switch back for good
+static void coroutineEntry(void) {
+    Coroutine* co = currentCoroutine;
+    co->fn(co->arg);
+    co->finished = 1;
+#if defined(__x86_64__)
+    coroutineSwitch(&co->sp, co->callerSp);
+#else
+    swapcontext(&co->context, &co->callerContext);
+#endif
+    abort();  // A finished coroutine is never resumed
+}
+
+// Guard a quarter of the kernel's mapping limit, leaving room for everything else
+static long initialGuardBudget(void) {
+    long maxMaps = 65530;
+    FILE* f = fopen("/proc/sys/vm/max_map_count", "r");
+    if (f != NULL) {
+        if (fscanf(f, "%ld", &maxMaps) != 1) maxMaps = 65530;
+        fclose(f);
+    }
+    return maxMaps / 4;
+}
+
+// Map a slab of stacks and add them to the free list - caller holds poolLock
+static int growStackPool(void) {
+    if (guardBudget < 0) guardBudget = initialGuardBudget();
+
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+    size_t slot = page + COROUTINE_STACK_SIZE;
+    size_t length = slot * STACKS_PER_SLAB;
+
+    char* base = (char*)mmap(NULL, length, PROT_READ | PROT_WRITE,
+                             MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (base == MAP_FAILED) return 0;
+
+    StackSlab* slab = (StackSlab*)malloc(sizeof(StackSlab));
+    slab->base = base;
+    slab->length = length;
+    slab->next = slabs;
+    slabs = slab;
+
+    for (int i = 0; i < STACKS_PER_SLAB; i++) {
+        char* slotBase = base + i * slot;
+        if (guardBudget > 0 && mprotect(slotBase, page, PROT_NONE) == 0) {
+            guardBudget--;  // Guard page below the stack
+        }
+
+        // The coroutine record lives at the top of its own stack
+        Coroutine* co = (Coroutine*)(slotBase + slot - sizeof(Coroutine));
+        co->nextFree = freeCoroutines;
+        freeCoroutines = co;
+    }
+    return 1;
+}
+
+// Create a suspended coroutine that will run fn(arg) on first resume
+Coroutine* createCoroutine(CoroutineFn fn, void* arg) {
+    pthread_mutex_lock(&poolLock);
+    if (freeCoroutines == NULL && !growStackPool()) {
+        pthread_mutex_unlock(&poolLock);
+        return NULL;
+    }
+    Coroutine* co = freeCoroutines;
+    freeCoroutines = co->nextFree;
+    pthread_mutex_unlock(&poolLock);
+
+    co->fn = fn;
+    co->arg = arg;
+    co->finished = 0;
+    co->nextFree = NULL;
+
+    char* stackTop = (char*)co;
+    char* stackLow = stackTop - COROUTINE_STACK_SIZE + sizeof(Coroutine);
+#if defined(__x86_64__)
+    // Build a frame that coroutineSwitch "returns" into: six zeroed
+    // callee-saved registers, then coroutineEntry, then a dummy return slot
+    uintptr_t top = ((uintptr_t)stackTop) & ~(uintptr_t)15;
+    void** frame = (void**)(top - 16);
+    frame[1] = NULL;
+    frame[0] = (void*)coroutineEntry;
+    frame -= 6;
+    for (int i = 0; i < 6; i++) frame[i] = NULL;
+    co->sp = frame;
+    (void)stackLow;
+#else
+    getcontext(&co->context);
+    co->context.uc_stack.ss_sp = stackLow;
+    co->context.uc_stack.ss_size = stackTop - stackLow;
+    co->context.uc_link = NULL;
+    makecontext(&co->context, coroutineEntry, 0);
+#endif
+    return co;
+}
+
+// Run co until it yields or returns - returns 1 while it still has work left
+int resumeCoroutine(Coroutine* co) {
+    if (co == NULL || co->finished) return 0;
+
+    Coroutine* previous = currentCoroutine;
+    currentCoroutine = co;
+#if defined(__x86_64__)
+    coroutineSwitch(&co->callerSp, co->sp);
+#else
+    swapcontext(&co->callerContext, &co->context);
+#endif
+    currentCoroutine = previous;
+    return !co->finished;
+}
+
+// Suspend the running coroutine and return to its resumer
+void yieldCoroutine(void) {
+    Coroutine* co = currentCoroutine;
+    if (co == NULL) return;  // Not inside a coroutine
+#if defined(__x86_64__)
+    coroutineSwitch(&co->sp, co->callerSp);
+#else
+    swapcontext(&co->context, &co->callerContext);
+#endif
+}
+
+// Return a coroutine's stack to the pool; it must not be running
+void destroyCoroutine(Coroutine* co) {
+    if (co == NULL) return;
+    pthread_mutex_lock(&poolLock);
+    co->nextFree = freeCoroutines;
+    freeCoroutines = co;
+    pthread_mutex_unlock(&poolLock);
+}
+
+// Unmap every pooled stack; only valid once no coroutine is in use
+void releaseCoroutinePool(void) {
+    pthread_mutex_lock(&poolLock);
+    while (slabs != NULL) {
+        StackSlab* temp = slabs;
+        slabs = slabs->next;
+        munmap(temp->base, temp->length);
+        free(temp);
+    }
+    freeCoroutines = NULL;
+    pthread_mutex_unlock(&poolLock);
+}
@@ -0,0 +1,623 @@
+#include "daemon.h"
+#include "task_io.h"
+#include "sharded_scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <errno.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/epoll.h>
+
+#define MAX_EVENTS 64
+#define CLIENT_BUFFER_SIZE 65536
+#define MAX_PENDING_OUTPUT (4 * 1024 * 1024)
+#define SHARD_RETRY_MS 10    // Shard workers drain queues without waking epoll
+
+// Per-connection state: partial input line and queued replies
+typedef struct Client {
+    int fd;
+    char in[CLIENT_BUFFER_SIZE];
+    int inLen;
+    char* out;
+    size_t outLen;
+    size_t outSent;
+    size_t outCap;
+    int closing;
+    int halfClosed;      // Peer shut down its write side but still reads replies
+    int blocked;         // Parked on a SUBMIT refused with SUBMIT_WOULD_BLOCK
+    int waited;          // The parked line is already counted in stats.blocked
+    unsigned events;     // Currently registered epoll interest
+    struct Client* nextBlocked;
+} Client;
+
+static volatile sig_atomic_t stopRequested = 0;
+static Client* blockedClients = NULL;
+static const char* dataDirectory = NULL;  // The only place IMPORT/EXPORT may touch
+static ShardedScheduler* shardFront = NULL;   // Set when serving shards instead of one scheduler
+static long shardBlocked = 0;                 // Parked submissions while serving shards
+
+static void handleStopSignal(int sig) {
+    (void)sig;
+    stopRequested = 1;
+}
+
+static int setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    if (flags < 0) return -1;
+    return fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+}
+
+// Resolve a client-supplied file name inside the data directory - returns 0 if
+// none is configured or the name is empty, hidden, has a '/' or does not fit
+static int dataPath(const char* name, char* path, size_t size) {
+    if (dataDirectory == NULL || name[0] == '\0' || name[0] == '.' || strchr(name, '/') != NULL) {
+        return 0;
+    }
+    int n = snprintf(path, size, "%s/%s", dataDirectory, name);
+    return n > 0 && (size_t)n < size;
+}
+
+// Append formatted reply to client's output buffer - amortized O(1) per byte
+static void reply(Client* client, const char* fmt, ...) __attribute__((format(printf, 2, 3)));
+static void reply(Client* client, const char* fmt, ...) {
+    va_list args;
+    for (;;) {
+        size_t room = client->outCap - client->outLen;
+        va_start(args, fmt);
+        int n = vsnprintf(client->out + client->outLen, room, fmt, args);
+        va_end(args);
+        if (n < 0) return;
+        if ((size_t)n < room) {
+            client->outLen += n;
+            return;
+        }
+        size_t newCap = client->outCap ? client->outCap * 2 : 4096;
+        while (newCap - client->outLen <= (size_t)n) newCap *= 2;
+        client->out = (char*)realloc(client->out, newCap);
+        client->outCap = newCap;
+    }
+}
+
+// Parse a decimal integer and advance the cursor - returns 0 on failure,
+// including values outside the int range
+static int parseInt(char** cursor, int* value) {
+    char* end;
+    errno = 0;
+    long v = strtol(*cursor, &end, 10);
+    if (end == *cursor || errno == ERANGE || v < INT_MIN || v > INT_MAX) return 0;
+    *value = (int)v;
+    while (*end == ' ') end++;
+    *cursor = end;
+    return 1;
+}
+
+// Execute one command against the shards; their workers run tasks on their
+// own, so only submission, cancel, pause, resume and the merged views are offered
+static int handleShardCommand(Client* client, const char* line, int cmdLen, char* args) {
+    int a, b;
+    if (cmdLen == 6 && strncmp(line, "SUBMIT", 6) == 0) {
+        if (!parseInt(&args, &a) || !parseInt(&args, &b) || *args == '\0') {
+            reply(client, "ERR usage: SUBMIT <priority> <execTime> <name>\n");
+            return 0;
+        }
+        int id = shardedSubmit(shardFront, args, a, b);
+        if (id == SUBMIT_WOULD_BLOCK) return 1;  // Retried every SHARD_RETRY_MS
+        if (id == SUBMIT_REJECTED) {
+            reply(client, "ERR rejected\n");
+        } else {
+            reply(client, "OK %d\n", id);
+        }
+    } else if (cmdLen == 6 && strncmp(line, "CANCEL", 6) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: CANCEL <id>\n");
+        } else if (shardedCancel(shardFront, a)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 5 && strncmp(line, "PAUSE", 5) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: PAUSE <id>\n");
+        } else if (shardedPause(shardFront, a)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 6 && strncmp(line, "RESUME", 6) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: RESUME <id>\n");
+        } else if (shardedResume(shardFront, a)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 4 && strncmp(line, "LIST", 4) == 0) {
+        Task* tasks;
+        int count = snapshotShardedTasks(shardFront, &tasks);
+        reply(client, "OK %d", count);
+        for (int i = 0; i < count; i++) reply(client, " %d", tasks[i].id);
+        reply(client, "\n");
+        free(tasks);
+    } else if (cmdLen == 5 && strncmp(line, "STATS", 5) == 0) {
+        SchedulerStats total;
+        int queued;
+        shardedStats(shardFront, &total, &queued);
+        reply(client, "STATS mode=%s shards=%d queued=%d submitted=%ld completed=%ld "
+                      "cancelled=%ld resumed=%ld rejected=%ld blocked=%ld evicted=%ld shed=%ld\n",
+              modeToString(shardFront->shards[0].scheduler.mode), shardFront->shardCount,
+              queued, total.submitted, total.completed, total.cancelled, total.resumed,
+              total.rejected, total.blocked + shardBlocked, total.evicted, total.shed);
+    } else if (cmdLen == 4 && strncmp(line, "QUIT", 4) == 0) {
+        client->closing = 1;
+    } else if (cmdLen > 0) {
+        reply(client, "ERR unsupported with shards\n");
+    }
+    return 0;
+}
+
+// Execute one command line and queue its reply - returns 1 if the line must wait
+static int handleCommand(TaskScheduler* scheduler, Client* client, char* line) {
+    char* args = line;
+    while (*args != '\0' && *args != ' ') args++;
+    int cmdLen = (int)(args - line);
+    while (*args == ' ') args++;
+    if (shardFront != NULL) return handleShardCommand(client, line, cmdLen, args);
+
+    int a, b;
+    int tenant = DEFAULT_TENANT;
+    if ((cmdLen == 6 && strncmp(line, "SUBMIT", 6) == 0) ||
+        (cmdLen == 7 && strncmp(line, "TSUBMIT", 7) == 0)) {
+        if ((cmdLen == 7 && !parseInt(&args, &tenant)) ||
+            !parseInt(&args, &a) || !parseInt(&args, &b) || *args == '\0') {
+            reply(client, cmdLen == 7 ? "ERR usage: TSUBMIT <tenant> <priority> <execTime> <name>\n"
+                                      : "ERR usage: SUBMIT <priority> <execTime> <name>\n");
+            return 0;
+        }
+        int id = submitTenantTask(scheduler, tenant, args, a, b);
+        if (id == SUBMIT_WOULD_BLOCK) return 1;  // Retried once the queue drains
+        if (id == SUBMIT_REJECTED) {
+            reply(client, "ERR rejected\n");
+        } else {
+            reply(client, "OK %d\n", id);
+        }
+    } else if (cmdLen == 7 && strncmp(line, "CSUBMIT", 7) == 0) {
+        if (!parseInt(&args, &a) || !parseInt(&args, &b) || b < 1 || *args == '\0') {
+            reply(client, "ERR usage: CSUBMIT <priority> <steps> <name>\n");
+            return 0;
+        }
+        int id = submitSteppedTask(scheduler, args, a, b);
+        if (id == SUBMIT_WOULD_BLOCK) return 1;
+        if (id == SUBMIT_REJECTED) {
+            reply(client, "ERR rejected\n");
+        } else if (id == 0) {
+            reply(client, "ERR nostack\n");
+        } else {
+            reply(client, "OK %d\n", id);
+        }
+    } else if (cmdLen == 6 && strncmp(line, "CANCEL", 6) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: CANCEL <id>\n");
+        } else if (cancelTask(scheduler, a)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 5 && strncmp(line, "PURGE", 5) == 0) {
+        TaskFilter filter;
+        if (strncmp(args, "NAME ", 5) == 0 && args[5] != '\0') {
+            filter.kind = FILTER_NAME_PREFIX;
+            filter.prefix = args + 5;
+        } else if (strncmp(args, "PRIORITY ", 9) == 0 || strncmp(args, "ID ", 3) == 0) {
+            filter.kind = args[0] == 'P' ? FILTER_PRIORITY_RANGE : FILTER_ID_RANGE;
+            args += filter.kind == FILTER_PRIORITY_RANGE ? 9 : 3;
+            if (!parseInt(&args, &filter.low) || !parseInt(&args, &filter.high)) {
+                reply(client, "ERR usage: PURGE PRIORITY|ID <low> <high>\n");
+                return 0;
+            }
+        } else {
+            reply(client, "ERR usage: PURGE NAME <prefix> | PURGE PRIORITY|ID <low> <high>\n");
+            return 0;
+        }
+        reply(client, "OK %d\n", removeWhere(scheduler, matchTaskFilter, &filter));
+    } else if (cmdLen == 5 && strncmp(line, "PAUSE", 5) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: PAUSE <id>\n");
+        } else if (pauseTaskById(scheduler, a)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 6 && strncmp(line, "RESUME", 6) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: RESUME <id>\n");
+        } else if (resumeTaskById(scheduler, a)) {
+            reply(client, "OK %d\n", a);
+        } else if (findInIndex(&scheduler->index, a) != NULL) {
+            reply(client, "ERR notpaused\n");  // Already resumed and waiting to run
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 12 && strncmp(line, "REPRIORITIZE", 12) == 0) {
+        if (!parseInt(&args, &a) || !parseInt(&args, &b)) {
+            reply(client, "ERR usage: REPRIORITIZE <id> <priority>\n");
+        } else if (reprioritizeTask(scheduler, a, b)) {
+            reply(client, "OK %d\n", a);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 3 && strncmp(line, "RUN", 3) == 0) {
+        if (!parseInt(&args, &a)) a = 1;
+        int ran = 0;
+        while (ran < a && completeNextTask(scheduler, NULL)) ran++;
+        reply(client, "OK %d\n", ran);
+    } else if (cmdLen == 4 && strncmp(line, "RANK", 4) == 0) {
+        int rank = parseInt(&args, &a) ? rankInIndex(&scheduler->index, a) : 0;
+        if (rank > 0) {
+            reply(client, "OK %d\n", rank);
+        } else {
+            reply(client, "ERR notfound\n");
+        }
+    } else if (cmdLen == 5 && strncmp(line, "ABOVE", 5) == 0) {
+        if (!parseInt(&args, &a)) {
+            reply(client, "ERR usage: ABOVE <priority>\n");
+        } else {
+            reply(client, "OK %d\n", countAbovePriority(&scheduler->index, a));
+        }
+    } else if (cmdLen == 5 && strncmp(line, "RANGE", 5) == 0) {
+        if (!parseInt(&args, &a) || !parseInt(&args, &b)) {
+            reply(client, "ERR usage: RANGE <low> <high>\n");
+            return 0;
+        }
+        int count = countPriorityRange(&scheduler->index, a, b);
+        reply(client, "OK %d", count);
+        if (count > 0) {
+            Task* tasks = (Task*)malloc(count * sizeof(Task));
+            listPriorityRange(&scheduler->index, a, b, tasks, count);
+            for (int i = 0; i < count; i++) reply(client, " %d", tasks[i].id);
+            free(tasks);
+        }
+        reply(client, "\n");
+    } else if (cmdLen == 6 && strncmp(line, "WEIGHT", 6) == 0) {
+        if (!parseInt(&args, &tenant) || !parseInt(&args, &a) || a < 1) {
+            reply(client, "ERR usage: WEIGHT <tenant> <weight>\n");
+        } else {
+            setTenantWeight(&scheduler->fairQueue, tenant, a);
+            reply(client, "OK %d\n", tenant);
+        }
+    } else if (cmdLen == 5 && strncmp(line, "SHARE", 5) == 0) {
+        const FairQueue* fq = &scheduler->fairQueue;
+        const Tenant* t = parseInt(&args, &tenant) ? findTenant(fq, tenant) : NULL;
+        if (t == NULL) {
+            reply(client, "ERR notfound\n");
+        } else {
+            reply(client, "OK weight=%d queued=%d dispatched=%ld service=%ld share=%.1f target=%.1f\n",
+                  t->weight, t->queue.count, t->dispatched, t->serviceTime,
+                  fq->totalService > 0 ? 100.0 * t->serviceTime / fq->totalService : 0.0,
+                  100.0 * t->weight / fq->totalWeight);
+        }
+    } else if (cmdLen == 6 && strncmp(line, "IMPORT", 6) == 0) {
+        char path[PATH_MAX];
+        long errorLine;
+        int full;
+        if (!dataPath(args, path, sizeof(path))) {
+            reply(client, dataDirectory == NULL ? "ERR no data directory\n" : "ERR bad file name\n");
+            return 0;
+        }
+        long loaded = importTasks(scheduler, path, &errorLine, &full);
+        if (loaded < 0) {
+            reply(client, "ERR import failed\n");
+        } else if (full) {
+            reply(client, "ERR full after %ld tasks\n", loaded);
+        } else if (errorLine > 0) {
+            reply(client, "ERR malformed entry %ld after %ld tasks\n", errorLine, loaded);
+        } else {
+            reply(client, "OK %ld\n", loaded);
+        }
+    } else if (cmdLen == 6 && strncmp(line, "EXPORT", 6) == 0) {
+        TaskFileFormat format;
+        if (strncmp(args, "BINARY ", 7) == 0 && args[7] != '\0') {
+            format = TASKFILE_BINARY;
+            args += 7;
+        } else if (strncmp(args, "CSV ", 4) == 0 && args[4] != '\0') {
+            format = TASKFILE_CSV;
+            args += 4;
+        } else {
+            reply(client, "ERR usage: EXPORT BINARY|CSV <file>\n");
+            return 0;
+        }
+        char path[PATH_MAX];
+        if (!dataPath(args, path, sizeof(path))) {
+            reply(client, dataDirectory == NULL ? "ERR no data directory\n" : "ERR bad file name\n");
+            return 0;
+        }
+        long written = exportTasks(scheduler, path, format);
+        if (written < 0) {
+            reply(client, "ERR export failed\n");
+        } else {
+            reply(client, "OK %ld\n", written);
+        }
+    } else if (cmdLen == 5 && strncmp(line, "STATS", 5) == 0) {
+        reply(client, "STATS mode=%s queued=%d history=%d submitted=%ld completed=%ld "
+                      "cancelled=%ld resumed=%ld rejected=%ld blocked=%ld evicted=%ld "
+                      "shed=%ld shedding=%d tenants=%d\n",
+              modeToString(scheduler->mode),
+              queuedCount(scheduler), scheduler->history.count,
+              scheduler->stats.submitted, scheduler->stats.completed,
+              scheduler->stats.cancelled, scheduler->stats.resumed,
+              scheduler->stats.rejected, scheduler->stats.blocked,
+              scheduler->stats.evicted, scheduler->stats.shed, scheduler->shedding,
+              scheduler->fairQueue.tenantCount);
+    } else if (cmdLen == 4 && strncmp(line, "QUIT", 4) == 0) {
+        client->closing = 1;
+    } else if (cmdLen > 0) {
+        reply(client, "ERR unknown command\n");
+    }
+    return 0;
+}
+
+// Run every complete line in the input buffer - Time Complexity: O(bytes)
+static void processInput(TaskScheduler* scheduler, Client* client) {
+    int start = 0;
+    for (int i = 0; i < client->inLen && !client->closing; i++) {
+        if (client->in[i] != '\n') continue;
+        int end = i;
+        if (end > start && client->in[end - 1] == '\r') end--;
+        char terminator = client->in[end];
+        client->in[end] = '\0';
+        if (handleCommand(scheduler, client, client->in + start)) {
+            // Keep the line and stop reading from this client until there is room
+            client->in[end] = terminator;
+            if (!client->waited) {
+                if (shardFront != NULL) {
+                    shardBlocked++;
+                } else {
+                    scheduler->stats.blocked++;
+                }
+                client->waited = 1;
+            }
+            client->blocked = 1;
+            client->nextBlocked = blockedClients;
+            blockedClients = client;
+            break;
+        }
+        client->waited = 0;
+        start = i + 1;
+    }
+
+    if (start > 0) {
+        memmove(client->in, client->in + start, client->inLen - start);
+        client->inLen -= start;
+    } else if (!client->blocked && client->inLen == CLIENT_BUFFER_SIZE) {
+        // A single line filled the whole buffer; drop it
+        reply(client, "ERR line too long\n");
+        client->inLen = 0;
+    }
+}
+
+// Write as much queued output as the socket accepts - returns -1 on error
+static int flushOutput(Client* client) {
+    while (client->outSent < client->outLen) {
+        ssize_t n = write(client->fd, client->out + client->outSent,
+                          client->outLen - client->outSent);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return 0;
+            return -1;
+        }
+        client->outSent += n;
+    }
+    client->outLen = client->outSent = 0;
+    return 0;
+}
+
+static void closeClient(int epfd, Client* client) {
+    Client** link = &blockedClients;
+    while (*link != NULL && *link != client) link = &(*link)->nextBlocked;
+    if (*link != NULL) *link = client->nextBlocked;
+
+    epoll_ctl(epfd, EPOLL_CTL_DEL, client->fd, NULL);
+    close(client->fd);
+    free(client->out);
+    free(client);
+}
+
+// Re-arm epoll interest: stop reading while the client is not draining replies
+static void updateInterest(int epfd, Client* client) {
+    size_t pending = client->outLen - client->outSent;
+    int reading = pending < MAX_PENDING_OUTPUT && !client->closing && !client->blocked;
+    unsigned hangup = client->halfClosed ? 0 : EPOLLRDHUP;  // Reported once is enough
+    unsigned wanted = (reading ? EPOLLIN | hangup : 0) |
+                      (client->blocked ? hangup : 0) |
+                      (pending > 0 ? EPOLLOUT : 0);
+    if (wanted == client->events) return;
+
+    struct epoll_event ev;
+    ev.events = wanted;
+    ev.data.ptr = client;
+    epoll_ctl(epfd, EPOLL_CTL_MOD, client->fd, &ev);
+    client->events = wanted;
+}
+
+// Drain readable data, run commands and send the batched replies
+static int serviceClient(TaskScheduler* scheduler, int epfd, Client* client, unsigned events) {
+    if ((events & EPOLLIN) && !client->closing && !client->blocked) {
+        for (;;) {
+            ssize_t n = read(client->fd, client->in + client->inLen,
+                             CLIENT_BUFFER_SIZE - client->inLen);
+            if (n == 0) {
+                client->closing = 1;
+                break;
+            }
+            if (n < 0) {
+                if (errno == EINTR) continue;
+                if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+                return -1;
+            }
+            client->inLen += n;
+            processInput(scheduler, client);
+            if (client->closing || client->blocked) break;
+        }
+    } else if (events & (EPOLLERR | EPOLLHUP)) {
+        // Gone while parked or while its replies were pending: nobody is left to answer
+        return -1;
+    } else if (events & EPOLLRDHUP) {
+        // Half-closed after pipelining a batch: its parked lines still run, and
+        // the end of input is read once it is unparked
+        client->halfClosed = 1;
+    }
+
+    // A closing client stays registered until its last replies are written
+    if (flushOutput(client) < 0) return -1;
+    if (client->closing && client->outLen == 0) return -1;
+    updateInterest(epfd, client);
+    return 0;
+}
+
+// Give parked clients another try once admission control lets work in again
+static void retryBlockedClients(TaskScheduler* scheduler, int epfd) {
+    if (shardFront == NULL) {
+        const AdmissionConfig* admission = &scheduler->admission;
+        if (admission->capacity > 0 && queuedCount(scheduler) >= admission->capacity) return;
+    }
+
+    Client* parked = blockedClients;
+    blockedClients = NULL;
+    while (parked != NULL) {
+        Client* client = parked;
+        parked = parked->nextBlocked;
+        client->blocked = 0;
+        client->nextBlocked = NULL;
+
+        processInput(scheduler, client);
+        if (flushOutput(client) < 0 || (client->closing && client->outLen == 0)) {
+            closeClient(epfd, client);
+        } else {
+            updateInterest(epfd, client);
+        }
+    }
+}
+
+static void acceptClients(int epfd, int listenFd) {
+    for (;;) {
+        int fd = accept(listenFd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;  // EAGAIN or transient failure
+        }
+        setNonBlocking(fd);
+
+        Client* client = (Client*)calloc(1, sizeof(Client));
+        client->fd = fd;
+        client->events = EPOLLIN | EPOLLRDHUP;
+
+        struct epoll_event ev;
+        ev.events = client->events;
+        ev.data.ptr = client;
+        if (epoll_ctl(epfd, EPOLL_CTL_ADD, fd, &ev) < 0) {
+            close(fd);
+            free(client);
+        }
+    }
+}
+
+static int openListener(const char* socketPath) {
+    struct sockaddr_un addr;
+    if (strlen(socketPath) >= sizeof(addr.sun_path)) {
+        fprintf(stderr, "  Error: Socket path too long: %s\n", socketPath);
+        return -1;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        perror("  socket");
+        return -1;
+    }
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socketPath);
+    unlink(socketPath);
+
+    if (bind(fd, (struct sockaddr*)&addr, sizeof(addr)) < 0 || listen(fd, SOMAXCONN) < 0) {
+        perror("  bind/listen");
+        close(fd);
+        return -1;
+    }
+    setNonBlocking(fd);
+    return fd;
+}
+
+// Event loop shared by both daemon flavours; scheduler is NULL when serving shards
+static int serve(TaskScheduler* scheduler, const char* socketPath) {
+    int listenFd = openListener(socketPath);
+    if (listenFd < 0) return 1;
+
+    int epfd = epoll_create1(0);
+    if (epfd < 0) {
+        perror("  epoll_create1");
+        close(listenFd);
+        unlink(socketPath);
+        return 1;
+    }
+
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;  // NULL marks the listening socket
+    epoll_ctl(epfd, EPOLL_CTL_ADD, listenFd, &ev);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = handleStopSignal;
+    sigaction(SIGINT, &sa, NULL);
+    sigaction(SIGTERM, &sa, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    printf("  Task scheduler daemon listening on %s\n", socketPath);
+    fflush(stdout);
+
+    struct epoll_event events[MAX_EVENTS];
+    while (!stopRequested) {
+        int timeout = shardFront != NULL && blockedClients != NULL ? SHARD_RETRY_MS : -1;
+        int n = epoll_wait(epfd, events, MAX_EVENTS, timeout);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            perror("  epoll_wait");
+            break;
+        }
+
+        for (int i = 0; i < n; i++) {
+            Client* client = (Client*)events[i].data.ptr;
+            if (client == NULL) {
+                acceptClients(epfd, listenFd);
+            } else if (serviceClient(scheduler, epfd, client, events[i].events) < 0) {
+                closeClient(epfd, client);
+            }
+        }
+        if (blockedClients != NULL) retryBlockedClients(scheduler, epfd);
+    }
+
+    printf("\n  Daemon shutting down...\n");
+    close(epfd);
+    close(listenFd);
+    unlink(socketPath);
+    return 0;
+}
+
+// Serve the scheduler over a UNIX-domain socket until SIGINT/SIGTERM; IMPORT
+// and EXPORT are refused unless dataDir names a directory for task files
+int runDaemon(TaskScheduler* scheduler, const char* socketPath, const char* dataDir) {
+    dataDirectory = dataDir;
+    return serve(scheduler, socketPath);
+}
+
+// Serve a running sharded scheduler the same way, with the reduced command set
+int runShardedDaemon(ShardedScheduler* ss, const char* socketPath) {
+    shardFront = ss;
+    return serve(NULL, socketPath);
+}
@@ -0,0 +1,265 @@
+#include "fair_queue.h"
+#include "heap_template.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define INITIAL_TENANT_BUCKETS 16
+#define INITIAL_ACTIVE_CAPACITY 16
+
+// Min-heap of tenants by virtual runtime (lower ID first on ties); every
+// tenant keeps its current slot in heapIndex
+#define TENANT_BEFORE(a, b) ((a)->vruntime < (b)->vruntime || \
+                             ((a)->vruntime == (b)->vruntime && (a)->id < (b)->id))
+#define TENANT_MOVED(tenant, index) ((tenant)->heapIndex = (index))
+DEFINE_TRACKED_HEAP(tenantHeap, Tenant*, TENANT_BEFORE, TENANT_MOVED)
+
+static unsigned int tenantBucket(const FairQueue* fq, int id) {
+    return ((unsigned int)id * 2654435761u) & (unsigned int)(fq->bucketCount - 1);
+}
+
+// Initialize an empty fair queue
+void initFairQueue(FairQueue* fq) {
+    fq->bucketCount = INITIAL_TENANT_BUCKETS;
+    fq->buckets = (Tenant**)calloc(INITIAL_TENANT_BUCKETS, sizeof(Tenant*));
+    fq->tenantCount = 0;
+    fq->activeCapacity = INITIAL_ACTIVE_CAPACITY;
+    fq->active = (Tenant**)malloc(INITIAL_ACTIVE_CAPACITY * sizeof(Tenant*));
+    fq->activeCount = 0;
+    fq->minVruntime = 0;
+    fq->totalService = 0;
+    fq->totalWeight = 0;
+    fq->size = 0;
+}
+
+// Look up a tenant by ID - Time Complexity: O(1) expected
+Tenant* findTenant(const FairQueue* fq, int id) {
+    Tenant* tenant = fq->buckets[tenantBucket(fq, id)];
+    while (tenant != NULL && tenant->id != id) tenant = tenant->hashNext;
+    return tenant;
+}
+
+// Double the tenant table - Time Complexity: O(tenants)
+static void growTenantBuckets(FairQueue* fq) {
+    Tenant** old = fq->buckets;
+    int oldCount = fq->bucketCount;
+    fq->bucketCount *= 2;
+    fq->buckets = (Tenant**)calloc(fq->bucketCount, sizeof(Tenant*));
+    for (int i = 0; i < oldCount; i++) {
+        Tenant* tenant = old[i];
+        while (tenant != NULL) {
+            Tenant* next = tenant->hashNext;
+            unsigned int b = tenantBucket(fq, tenant->id);
+            tenant->hashNext = fq->buckets[b];
+            fq->buckets[b] = tenant;
+            tenant = next;
+        }
+    }
+    free(old);
+}
+
+// Find a tenant, registering it with the default weight on first use - Time Complexity: O(1) expected
+Tenant* getTenant(FairQueue* fq, int id) {
+    Tenant* tenant = findTenant(fq, id);
+    if (tenant != NULL) return tenant;
+
+    if (fq->tenantCount + 1 > fq->bucketCount) growTenantBuckets(fq);
+    tenant = (Tenant*)malloc(sizeof(Tenant));
+    tenant->id = id;
+    tenant->weight = DEFAULT_TENANT_WEIGHT;
+    tenant->vruntime = fq->minVruntime;
+    initQueue(&tenant->queue);
+    tenant->heapIndex = -1;
+    tenant->dispatched = 0;
+    tenant->serviceTime = 0;
+
+    unsigned int b = tenantBucket(fq, id);
+    tenant->hashNext = fq->buckets[b];
+    fq->buckets[b] = tenant;
+    fq->tenantCount++;
+    fq->totalWeight += tenant->weight;
+    return tenant;
+}
+
+// Set a tenant's share weight (minimum 1); applies to work dispatched from now on
+void setTenantWeight(FairQueue* fq, int id, int weight) {
+    if (weight < 1) weight = 1;
+    Tenant* tenant = getTenant(fq, id);
+    fq->totalWeight += weight - tenant->weight;
+    tenant->weight = weight;
+}
+
+// Queue a task behind its tenant's earlier work - returns its node - Time Complexity: O(log tenants)
+QueueNode* enqueueFair(FairQueue* fq, Task task) {
+    Tenant* tenant = getTenant(fq, task.tenant);
+    if (tenant->heapIndex < 0) {
+        // A tenant that sat idle does not get to bank the time it was away
+        if (tenant->vruntime < fq->minVruntime) tenant->vruntime = fq->minVruntime;
+        if (fq->activeCount == fq->activeCapacity) {
+            fq->activeCapacity *= 2;
+            fq->active = (Tenant**)realloc(fq->active, fq->activeCapacity * sizeof(Tenant*));
+        }
+        tenantHeapPush(fq->active, &fq->activeCount, tenant);
+    }
+    fq->size++;
+    return enqueue(&tenant->queue, task);
+}
+
+// Take the oldest task of the tenant with the least virtual runtime and charge
+// the tenant for it - Time Complexity: O(log tenants)
+Task dequeueFair(FairQueue* fq) {
+    if (fq->activeCount == 0) {
+        printf("  Error: Fair queue is empty!\n");
+        Task emptyTask = {0};
+        return emptyTask;
+    }
+
+    Tenant* tenant = fq->active[0];
+    Task task = dequeue(&tenant->queue);
+    fq->size--;
+
+    // Zero-length work still costs one unit so it cannot be queued for free
+    long cost = task.executionTime > 0 ? task.executionTime : 1;
+    tenant->vruntime += cost * VRUNTIME_SCALE / tenant->weight;
+    tenant->dispatched++;
+    tenant->serviceTime += task.executionTime;
+    fq->totalService += task.executionTime;
+
+    if (isQueueEmpty(&tenant->queue)) {
+        tenantHeapPopRoot(fq->active, &fq->activeCount);
+        tenant->heapIndex = -1;
+    } else {
+        tenantHeapSiftDown(fq->active, fq->activeCount, 0);
+    }
+
+    long floor = fq->activeCount > 0 ? fq->active[0]->vruntime : tenant->vruntime;
+    if (floor > fq->minVruntime) fq->minVruntime = floor;
+    return task;
+}
+
+// Check if no tenant has queued work - Time Complexity: O(1)
+int isFairEmpty(const FairQueue* fq) {
+    return fq->size == 0;
+}
+
+// Unlink a node obtained from enqueueFair, copying its task to removed if given
+// Time Complexity: O(log tenants)
+void removeNodeFromFair(FairQueue* fq, QueueNode* node, Task* removed) {
+    Tenant* tenant = findTenant(fq, node->task.tenant);
+    removeNodeFromQueue(&tenant->queue, node, removed);
+    fq->size--;
+    if (isQueueEmpty(&tenant->queue)) {
+        tenantHeapRemoveAt(fq->active, &fq->activeCount, tenant->heapIndex);
+        tenant->heapIndex = -1;
+    }
+}
+
+// Remove every queued task matching predicate in one pass over the active tenants,
+// then reheapify the ones still holding work - Time Complexity: O(n + tenants)
+int removeWhereFromFair(FairQueue* fq, TaskPredicate predicate, const void* ctx,
+                        TaskVisitor onRemoved, void* visitorCtx) {
+    int removed = 0;
+    int kept = 0;
+    for (int i = 0; i < fq->activeCount; i++) {
+        Tenant* tenant = fq->active[i];
+        removed += removeWhereFromQueue(&tenant->queue, predicate, ctx, onRemoved, visitorCtx);
+        if (isQueueEmpty(&tenant->queue)) {
+            tenant->heapIndex = -1;
+        } else {
+            fq->active[kept++] = tenant;
+        }
+    }
+    fq->activeCount = kept;
+    tenantHeapBuild(fq->active, fq->activeCount);
+    fq->size -= removed;
+    return removed;
+}
+
+// qsort comparator placing tenants in dispatch order
+static int compareTenantOrder(const void* a, const void* b) {
+    const Tenant* x = *(Tenant* const*)a;
+    const Tenant* y = *(Tenant* const*)b;
+    if (TENANT_BEFORE(x, y)) return -1;
+    if (TENANT_BEFORE(y, x)) return 1;
+    return 0;
+}
+
+// qsort comparator ordering tenants by ID
+static int compareTenantId(const void* a, const void* b) {
+    const Tenant* x = *(Tenant* const*)a;
+    const Tenant* y = *(Tenant* const*)b;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Display queued tasks tenant by tenant, next tenant to run first
+void displayFairQueue(const FairQueue* fq) {
+    if (fq->activeCount == 0) {
+        printf("  [Empty]\n");
+        return;
+    }
+
+    Tenant** order = (Tenant**)malloc(fq->activeCount * sizeof(Tenant*));
+    for (int i = 0; i < fq->activeCount; i++) order[i] = fq->active[i];
+    qsort(order, fq->activeCount, sizeof(Tenant*), compareTenantOrder);
+
+    for (int i = 0; i < fq->activeCount; i++) {
+        printf("\n  Tenant %d (weight %d, vruntime %ld):\n",
+               order[i]->id, order[i]->weight, order[i]->vruntime);
+        displayQueue(&order[i]->queue);
+    }
+    free(order);
+}
+
+// Display each tenant's weight, backlog and share of the service dispatched so far
+void displayTenantShares(const FairQueue* fq) {
+    if (fq->tenantCount == 0) {
+        printf("  [No tenants]\n");
+        return;
+    }
+
+    Tenant** tenants = (Tenant**)malloc(fq->tenantCount * sizeof(Tenant*));
+    int n = 0;
+    for (int b = 0; b < fq->bucketCount; b++) {
+        for (Tenant* tenant = fq->buckets[b]; tenant != NULL; tenant = tenant->hashNext) {
+            tenants[n++] = tenant;
+        }
+    }
+    qsort(tenants, n, sizeof(Tenant*), compareTenantId);
+
+    printf("  %-8s %-8s %-8s %-12s %-12s %-10s %-10s\n",
+           "Tenant", "Weight", "Queued", "Dispatched", "Service", "Share", "Target");
+    printf("  ---------------------------------------------------------------------\n");
+    for (int i = 0; i < n; i++) {
+        const Tenant* tenant = tenants[i];
+        double share = fq->totalService > 0 ? 100.0 * tenant->serviceTime / fq->totalService : 0.0;
+        double target = 100.0 * tenant->weight / fq->totalWeight;
+        char service[24], shareText[16], targetText[16];
+        snprintf(service, sizeof(service), "%lds", tenant->serviceTime);
+        snprintf(shareText, sizeof(shareText), "%.1f%%", share);
+        snprintf(targetText, sizeof(targetText), "%.1f%%", target);
+        printf("  %-8d %-8d %-8d %-12ld %-12s %-10s %-10s\n",
+               tenant->id, tenant->weight, tenant->queue.count,
+               tenant->dispatched, service, shareText, targetText);
+    }
+    free(tenants);
+}
+
+// Free every tenant and its queued tasks - Time Complexity: O(n + tenants)
+void freeFairQueue(FairQueue* fq) {
+    for (int b = 0; b < fq->bucketCount; b++) {
+        Tenant* tenant = fq->buckets[b];
+        while (tenant != NULL) {
+            Tenant* next = tenant->hashNext;
+            freeQueue(&tenant->queue);
+            free(tenant);
+            tenant = next;
+        }
+    }
+    free(fq->buckets);
+    free(fq->active);
+    fq->buckets = NULL;
+    fq->active = NULL;
+    fq->bucketCount = 0;
+    fq->tenantCount = 0;
+    fq->activeCount = 0;
+    fq->size = 0;
+}
@@ -7,9 +7,31 @@ void initHistory(TaskHistory* history) {
     history->head = NULL;
     history->tail = NULL;
     history->count = 0;
+    history->limit = 0;
 }
 
-// Add task to history - Time Complexity: O(1) with tail pointer
+// Unlink the oldest record that is not PAUSED; paused tasks wait for a resume
+// and are never dropped - Time Complexity: O(paused records ahead of it)
+static void dropOldestFinished(TaskHistory* history) {
+    HistoryNode* prev = NULL;
+    HistoryNode* current = history->head;
+    while (current != NULL && current->task.status == PAUSED) {
+        prev = current;
+        current = current->next;
+    }
+    if (current == NULL) return;
+
+    if (prev == NULL) {
+        history->head = current->next;
+    } else {
+        prev->next = current->next;
+    }
+    if (history->tail == current) history->tail = prev;
+    free(current);
+    history->count--;
+}
+
+// Add task to history, keeping within the limit - Time Complexity: O(1) with tail pointer
 void addToHistory(TaskHistory* history, Task task) {
     HistoryNode* newNode = (HistoryNode*)malloc(sizeof(HistoryNode));
     newNode->task = task;
@@ -24,6 +46,10 @@ void addToHistory(TaskHistory* history, Task task) {
         history->tail = newNode;
     }
     history->count++;
+    
+    if (history->limit > 0 && history->count > history->limit) {
+        dropOldestFinished(history);
+    }
 }
 
 // Display all tasks in history - Time Complexity: O(n)
@@ -0,0 +1,339 @@
+#include "order_index.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+
+#define INITIAL_BUCKETS 16
+
+// True if the node sorts strictly before key (priority, seq)
+static int precedes(const IndexNode* node, int priority, long seq) {
+    return node->priority > priority || (node->priority == priority && node->seq < seq);
+}
+
+static IndexNode* createNode(int level) {
+    IndexNode* node = (IndexNode*)malloc(sizeof(IndexNode) + level * sizeof(IndexLink));
+    node->task = NULL;
+    node->level = level;
+    node->hashNext = NULL;
+    for (int i = 0; i < level; i++) {
+        node->links[i].next = NULL;
+        node->links[i].span = 0;
+    }
+    return node;
+}
+
+// Geometric level with p = 1/4
+static int randomLevel(OrderIndex* index) {
+    int level = 1;
+    for (;;) {
+        index->rng ^= index->rng << 13;
+        index->rng ^= index->rng >> 17;
+        index->rng ^= index->rng << 5;
+        if ((index->rng & 3) != 0 || level == INDEX_MAX_LEVEL) break;
+        level++;
+    }
+    return level;
+}
+
+static unsigned int bucketOf(const OrderIndex* index, int id) {
+    return ((unsigned int)id * 2654435761u) & (unsigned int)(index->bucketCount - 1);
+}
+
+// Add a node to the ID table - Time Complexity: O(1)
+static void hashNode(OrderIndex* index, IndexNode* node) {
+    unsigned int b = bucketOf(index, node->id);
+    node->hashNext = index->buckets[b];
+    index->buckets[b] = node;
+}
+
+// Double the ID table until it has a bucket per linked or staged entry,
+// then rehash both - Time Complexity: O(n)
+static void growBuckets(OrderIndex* index) {
+    free(index->buckets);
+    do {
+        index->bucketCount *= 2;
+    } while (index->bucketCount < index->count + index->stagedCount);
+    index->buckets = (IndexNode**)calloc(index->bucketCount, sizeof(IndexNode*));
+    for (IndexNode* node = index->head->links[0].next; node != NULL; node = node->links[0].next) {
+        hashNode(index, node);
+    }
+    for (int i = 0; i < index->stagedCount; i++) hashNode(index, index->staged[i]);
+}
+
+// Make room in the ID table for one more entry - Time Complexity: O(1) amortized
+static void reserveBucket(OrderIndex* index) {
+    if (index->count + index->stagedCount + 1 > index->bucketCount) growBuckets(index);
+}
+
+// Look up a queued task by ID - Time Complexity: O(1) expected
+IndexNode* findInIndex(const OrderIndex* index, int id) {
+    IndexNode* node = index->buckets[bucketOf(index, id)];
+    while (node != NULL && node->id != id) node = node->hashNext;
+    return node;
+}
+
+// Initialize an empty index
+void initOrderIndex(OrderIndex* index) {
+    index->head = createNode(INDEX_MAX_LEVEL);
+    index->tail = NULL;
+    index->level = 1;
+    index->count = 0;
+    index->bucketCount = INITIAL_BUCKETS;
+    index->buckets = (IndexNode**)calloc(INITIAL_BUCKETS, sizeof(IndexNode*));
+    index->rng = 2463534242u;
+    index->staged = NULL;
+    index->stagedCount = 0;
+    index->stagedCapacity = 0;
+}
+
+// Link a detached, already hashed node into the skip list - Time Complexity: O(log n) expected
+static void linkNode(OrderIndex* index, IndexNode* node) {
+    IndexNode* update[INDEX_MAX_LEVEL];
+    int rank[INDEX_MAX_LEVEL];
+    IndexNode* x = index->head;
+
+    for (int i = index->level - 1; i >= 0; i--) {
+        rank[i] = (i == index->level - 1) ? 0 : rank[i + 1];
+        while (x->links[i].next != NULL && precedes(x->links[i].next, node->priority, node->seq)) {
+            rank[i] += x->links[i].span;
+            x = x->links[i].next;
+        }
+        update[i] = x;
+    }
+
+    int level = node->level;
+    if (level > index->level) {
+        for (int i = index->level; i < level; i++) {
+            rank[i] = 0;
+            update[i] = index->head;
+            update[i]->links[i].span = index->count;
+        }
+        index->level = level;
+    }
+
+    for (int i = 0; i < level; i++) {
+        node->links[i].next = update[i]->links[i].next;
+        update[i]->links[i].next = node;
+        node->links[i].span = update[i]->links[i].span - (rank[0] - rank[i]);
+        update[i]->links[i].span = rank[0] - rank[i] + 1;
+    }
+    for (int i = level; i < index->level; i++) {
+        update[i]->links[i].span++;
+    }
+    if (node->links[0].next == NULL) index->tail = node;
+    index->count++;
+}
+
+// Fill in a node's key and entry
+static void setEntry(IndexNode* node, Task* task) {
+    node->id = task->id;
+    node->priority = task->priority;
+    node->seq = task->seq;
+    node->task = task;
+}
+
+// Add a queued entry; task must stay where it is until it leaves the index
+// Time Complexity: O(log n) expected
+void insertIndex(OrderIndex* index, Task* task) {
+    reserveBucket(index);
+    IndexNode* node = createNode(randomLevel(index));
+    setEntry(node, task);
+    hashNode(index, node);
+    linkNode(index, node);
+}
+
+// Queue a task for the next mergeStagedIndex. findInIndex sees it at once so
+// duplicate IDs in a batch can be caught; order queries only after the merge
+// Time Complexity: O(1) amortized
+void stageIndex(OrderIndex* index, Task* task) {
+    reserveBucket(index);
+    if (index->stagedCount == index->stagedCapacity) {
+        index->stagedCapacity = index->stagedCapacity ? index->stagedCapacity * 2 : 1024;
+        index->staged = (IndexNode**)realloc(index->staged,
+                                             index->stagedCapacity * sizeof(IndexNode*));
+    }
+    IndexNode* node = createNode(randomLevel(index));
+    setEntry(node, task);
+    hashNode(index, node);
+    index->staged[index->stagedCount++] = node;
+}
+
+// qsort comparator in index order
+static int compareStaged(const void* a, const void* b) {
+    const IndexNode* x = *(IndexNode* const*)a;
+    const IndexNode* y = *(IndexNode* const*)b;
+    if (precedes(x, y->priority, y->seq)) return -1;
+    if (precedes(y, x->priority, x->seq)) return 1;
+    return 0;
+}
+
+// Link every staged entry. Large batches are sorted (skipped if already in
+// order) and merged with the existing entries while all levels are relinked
+// in one sequential pass - Time Complexity: O(n + k log k); small batches
+// are linked one by one in O(k log n)
+void mergeStagedIndex(OrderIndex* index) {
+    int k = index->stagedCount;
+    if (k == 0) return;
+    index->stagedCount = 0;
+
+    if ((long)k * 16 < index->count) {
+        for (int i = 0; i < k; i++) linkNode(index, index->staged[i]);
+        return;
+    }
+
+    IndexNode** staged = index->staged;
+    for (int i = 1; i < k; i++) {
+        if (compareStaged(&staged[i - 1], &staged[i]) > 0) {
+            qsort(staged, k, sizeof(IndexNode*), compareStaged);
+            break;
+        }
+    }
+
+    IndexNode* last[INDEX_MAX_LEVEL];
+    int lastRank[INDEX_MAX_LEVEL];
+    for (int i = 0; i < INDEX_MAX_LEVEL; i++) {
+        last[i] = index->head;
+        lastRank[i] = 0;
+    }
+
+    IndexNode* old = index->head->links[0].next;
+    int rank = 0;
+    int level = 1;
+    int next = 0;
+    while (old != NULL || next < k) {
+        IndexNode* node;
+        if (next == k || (old != NULL && precedes(old, staged[next]->priority, staged[next]->seq))) {
+            node = old;
+            old = old->links[0].next;
+        } else {
+            node = staged[next++];
+        }
+        rank++;
+        for (int i = 0; i < node->level; i++) {
+            last[i]->links[i].next = node;
+            last[i]->links[i].span = rank - lastRank[i];
+            last[i] = node;
+            lastRank[i] = rank;
+        }
+        if (node->level > level) level = node->level;
+    }
+    for (int i = 0; i < INDEX_MAX_LEVEL; i++) {
+        last[i]->links[i].next = NULL;
+        last[i]->links[i].span = (i < level) ? rank - lastRank[i] : 0;
+    }
+    index->level = level;
+    index->tail = last[0];
+    index->count = rank;
+}
+
+// Remove the entry for a task that left the queue - Time Complexity: O(log n) expected
+int removeFromIndex(OrderIndex* index, const Task* task) {
+    IndexNode* update[INDEX_MAX_LEVEL];
+    IndexNode* x = index->head;
+
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && precedes(x->links[i].next, task->priority, task->seq)) {
+            x = x->links[i].next;
+        }
+        update[i] = x;
+    }
+
+    IndexNode* node = x->links[0].next;
+    if (node == NULL || node->id != task->id || node->seq != task->seq) return 0;
+
+    for (int i = 0; i < index->level; i++) {
+        if (update[i]->links[i].next == node) {
+            update[i]->links[i].span += node->links[i].span - 1;
+            update[i]->links[i].next = node->links[i].next;
+        } else {
+            update[i]->links[i].span--;
+        }
+    }
+    if (node == index->tail) index->tail = (update[0] == index->head) ? NULL : update[0];
+    while (index->level > 1 && index->head->links[index->level - 1].next == NULL) {
+        index->level--;
+    }
+    index->count--;
+
+    // Unlink from the ID table
+    IndexNode** link = &index->buckets[bucketOf(index, task->id)];
+    while (*link != node) link = &(*link)->hashNext;
+    *link = node->hashNext;
+
+    free(node);
+    return 1;
+}
+
+// Number of queued tasks with priority strictly above the given one - Time Complexity: O(log n)
+int countAbovePriority(const OrderIndex* index, int priority) {
+    const IndexNode* x = index->head;
+    int rank = 0;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && x->links[i].next->priority > priority) {
+            rank += x->links[i].span;
+            x = x->links[i].next;
+        }
+    }
+    return rank;
+}
+
+// Number of queued tasks with low <= priority <= high - Time Complexity: O(log n)
+int countPriorityRange(const OrderIndex* index, int low, int high) {
+    if (low > high) return 0;
+    int atOrAboveLow = (low == INT_MIN) ? index->count : countAbovePriority(index, low - 1);
+    return atOrAboveLow - countAbovePriority(index, high);
+}
+
+// 1-based position of a task in (priority, arrival) order, 0 if absent - Time Complexity: O(log n)
+int rankInIndex(const OrderIndex* index, int id) {
+    const IndexNode* node = findInIndex(index, id);
+    if (node == NULL) return 0;
+
+    const IndexNode* x = index->head;
+    int rank = 0;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL &&
+               !precedes(node, x->links[i].next->priority, x->links[i].next->seq)) {
+            rank += x->links[i].span;
+            x = x->links[i].next;
+        }
+        if (x == node) return rank;
+    }
+    return 0;
+}
+
+// Copy up to maxOut tasks with low <= priority <= high into out, highest first
+// Time Complexity: O(log n + k)
+int listPriorityRange(const OrderIndex* index, int low, int high, Task* out, int maxOut) {
+    const IndexNode* x = index->head;
+    for (int i = index->level - 1; i >= 0; i--) {
+        while (x->links[i].next != NULL && x->links[i].next->priority > high) {
+            x = x->links[i].next;
+        }
+    }
+
+    int written = 0;
+    for (x = x->links[0].next; x != NULL && x->priority >= low && written < maxOut;
+         x = x->links[0].next) {
+        out[written++] = *x->task;
+    }
+    return written;
+}
+
+// Free all memory used by the index - Time Complexity: O(n)
+void freeOrderIndex(OrderIndex* index) {
+    IndexNode* node = index->head;
+    while (node != NULL) {
+        IndexNode* temp = node;
+        node = node->links[0].next;
+        free(temp);
+    }
+    for (int i = 0; i < index->stagedCount; i++) free(index->staged[i]);
+    free(index->buckets);
+    free(index->staged);
+    index->head = index->tail = NULL;
+    index->buckets = NULL;
+    index->staged = NULL;
+    index->count = 0;
+    index->stagedCount = index->stagedCapacity = 0;
+}
@@ -0,0 +1,280 @@
+#include "pairing_heap.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define MIN_CHUNK_SIZE 64
+#define MAX_CHUNK_SIZE 4096
+
+// Max order by priority, earlier arrival first on ties (same as the array heap)
+#define PAIRING_BEFORE(a, b) ((a)->task.priority > (b)->task.priority || \
+                              ((a)->task.priority == (b)->task.priority && (a)->task.seq < (b)->task.seq))
+
+// Initialize an empty pairing heap with no pooled memory
+void initPairingHeap(PairingHeap* ph) {
+    ph->root = NULL;
+    ph->size = 0;
+    ph->freeHead = ph->freeTail = NULL;
+    ph->chunks = ph->lastChunk = NULL;
+    ph->nextChunkSize = MIN_CHUNK_SIZE;
+}
+
+// Allocate a new chunk and thread its nodes onto the free list - amortized O(1)
+static void growPool(PairingHeap* ph) {
+    int count = ph->nextChunkSize;
+    PairingChunk* chunk = (PairingChunk*)malloc(sizeof(PairingChunk) + count * sizeof(PairingNode));
+    chunk->count = count;
+    chunk->next = ph->chunks;
+    ph->chunks = chunk;
+    if (ph->lastChunk == NULL) ph->lastChunk = chunk;
+
+    for (int i = 0; i < count - 1; i++) {
+        chunk->nodes[i].sibling = &chunk->nodes[i + 1];
+    }
+    chunk->nodes[count - 1].sibling = NULL;
+    ph->freeHead = &chunk->nodes[0];
+    ph->freeTail = &chunk->nodes[count - 1];
+
+    if (ph->nextChunkSize < MAX_CHUNK_SIZE) ph->nextChunkSize *= 2;
+}
+
+static PairingNode* allocNode(PairingHeap* ph) {
+    if (ph->freeHead == NULL) growPool(ph);
+    PairingNode* node = ph->freeHead;
+    ph->freeHead = node->sibling;
+    if (ph->freeHead == NULL) ph->freeTail = NULL;
+    return node;
+}
+
+static void releaseNode(PairingHeap* ph, PairingNode* node) {
+    node->sibling = ph->freeHead;
+    if (ph->freeHead == NULL) ph->freeTail = node;
+    ph->freeHead = node;
+}
+
+// Link two roots; the one that runs later becomes leftmost child - Time Complexity: O(1)
+static PairingNode* linkRoots(PairingNode* a, PairingNode* b) {
+    if (a == NULL) return b;
+    if (b == NULL) return a;
+    if (PAIRING_BEFORE(b, a)) {
+        PairingNode* temp = a;
+        a = b;
+        b = temp;
+    }
+
+    b->sibling = a->child;
+    if (a->child != NULL) a->child->prev = b;
+    b->prev = a;
+    a->child = b;
+    a->sibling = NULL;
+    a->prev = NULL;
+    return a;
+}
+
+// Two-pass pairing of a sibling list into one tree - amortized O(log n)
+static PairingNode* mergePairs(PairingNode* first) {
+    // Pass 1: link neighbours left to right, stacking the results
+    PairingNode* stack = NULL;
+    while (first != NULL) {
+        PairingNode* a = first;
+        PairingNode* b = a->sibling;
+        PairingNode* merged;
+        if (b == NULL) {
+            first = NULL;
+            merged = a;
+        } else {
+            first = b->sibling;
+            merged = linkRoots(a, b);
+        }
+        merged->sibling = stack;
+        stack = merged;
+    }
+
+    // Pass 2: fold the stack from right to left
+    PairingNode* result = NULL;
+    while (stack != NULL) {
+        PairingNode* next = stack->sibling;
+        result = linkRoots(stack, result);
+        stack = next;
+    }
+    return result;
+}
+
+// Insert task - returns its node as a handle for increaseKeyPairing - Time Complexity: O(1)
+PairingNode* insertPairing(PairingHeap* ph, Task task) {
+    PairingNode* node = allocNode(ph);
+    node->task = task;
+    node->child = node->sibling = node->prev = NULL;
+    ph->root = linkRoots(ph->root, node);
+    ph->size++;
+    return node;
+}
+
+// Extract maximum priority task - Time Complexity: amortized O(log n)
+Task extractMaxPairing(PairingHeap* ph) {
+    if (ph->root == NULL) {
+        printf("  Error: Pairing Heap is empty!\n");
+        Task emptyTask = {0};
+        return emptyTask;
+    }
+
+    PairingNode* oldRoot = ph->root;
+    Task maxTask = oldRoot->task;
+    ph->root = mergePairs(oldRoot->child);
+    if (ph->root != NULL) ph->root->prev = NULL;
+    ph->size--;
+
+    releaseNode(ph, oldRoot);
+    return maxTask;
+}
+
+// Cut a non-root node's subtree out of its parent's child list - Time Complexity: O(1)
+static void detachNode(PairingNode* node) {
+    if (node->prev->child == node) {
+        node->prev->child = node->sibling;
+    } else {
+        node->prev->sibling = node->sibling;
+    }
+    if (node->sibling != NULL) node->sibling->prev = node->prev;
+    node->sibling = node->prev = NULL;
+}
+
+// Remove a node returned by insertPairing, copying its task to removed if given
+// Time Complexity: amortized O(log n)
+void removeNodeFromPairing(PairingHeap* ph, PairingNode* node, Task* removed) {
+    if (removed != NULL) *removed = node->task;
+
+    PairingNode* children = mergePairs(node->child);
+    if (children != NULL) children->prev = NULL;
+    if (node == ph->root) {
+        ph->root = children;
+    } else {
+        detachNode(node);
+        ph->root = linkRoots(ph->root, children);
+    }
+    ph->size--;
+    releaseNode(ph, node);
+}
+
+// Remove every task matching predicate in one walk over all nodes, then pair
+// the survivors back into a single tree - Time Complexity: O(n)
+int removeWhereFromPairing(PairingHeap* ph, TaskPredicate predicate, const void* ctx,
+                           TaskVisitor onRemoved, void* visitorCtx) {
+    PairingNode* work = ph->root;
+    PairingNode* kept = NULL;
+    int removed = 0;
+
+    while (work != NULL) {
+        PairingNode* node = work;
+        work = node->sibling;
+
+        // Visit the node's children before the rest of the work list
+        if (node->child != NULL) {
+            PairingNode* last = node->child;
+            while (last->sibling != NULL) last = last->sibling;
+            last->sibling = work;
+            work = node->child;
+        }
+        node->child = node->prev = NULL;
+
+        if (predicate(&node->task, ctx)) {
+            if (onRemoved != NULL) onRemoved(&node->task, visitorCtx);
+            releaseNode(ph, node);
+            removed++;
+        } else {
+            node->sibling = kept;
+            kept = node;
+        }
+    }
+
+    ph->root = mergePairs(kept);
+    if (ph->root != NULL) ph->root->prev = NULL;
+    ph->size -= removed;
+    return removed;
+}
+
+// Raise a queued task's priority (decrease-key for a max-heap) - Time Complexity: O(1)
+int increaseKeyPairing(PairingHeap* ph, PairingNode* node, int newPriority) {
+    if (newPriority < node->task.priority) return 0;
+    node->task.priority = newPriority;
+    if (node == ph->root) return 1;
+
+    // Cut the subtree out of its parent's child list and relink it at the root
+    detachNode(node);
+    ph->root = linkRoots(ph->root, node);
+    return 1;
+}
+
+// Move every task of src into dst; src is left empty - Time Complexity: O(1)
+void meldPQ(PairingHeap* dst, PairingHeap* src) {
+    if (dst == src) return;
+
+    dst->root = linkRoots(dst->root, src->root);
+    dst->size += src->size;
+
+    // Take over src's pool so existing handles stay valid
+    if (src->chunks != NULL) {
+        src->lastChunk->next = dst->chunks;
+        if (dst->lastChunk == NULL) dst->lastChunk = src->lastChunk;
+        dst->chunks = src->chunks;
+    }
+    if (src->freeHead != NULL) {
+        src->freeTail->sibling = dst->freeHead;
+        if (dst->freeHead == NULL) dst->freeTail = src->freeTail;
+        dst->freeHead = src->freeHead;
+    }
+
+    initPairingHeap(src);
+}
+
+// Check if pairing heap is empty - Time Complexity: O(1)
+int isPairingEmpty(const PairingHeap* ph) {
+    return ph->root == NULL;
+}
+
+// Number of tasks in a subtree, walked without recursion since sorted input
+// can make the tree as deep as it is large - Time Complexity: O(subtree)
+static int subtreeSize(const PairingNode* top) {
+    const PairingNode* node = top;
+    int count = 0;
+    for (;;) {
+        count++;
+        if (node->child != NULL) {
+            node = node->child;
+            continue;
+        }
+        // Climb to the nearest ancestor below top that still has a right sibling
+        while (node != top && node->sibling == NULL) {
+            while (node->prev->child != node) node = node->prev;
+            node = node->prev;
+        }
+        if (node == top) return count;
+        node = node->sibling;
+    }
+}
+
+// Display the root and the subtrees that compete to replace it - Time Complexity: O(n)
+void displayPairingHeap(const PairingHeap* ph) {
+    if (ph->root == NULL) {
+        printf("  [Empty]\n");
+        return;
+    }
+
+    printf("\n  Pairing Heap (Max by Priority, %d tasks):\n", ph->size);
+    printf("  --------------------------------------------------\n");
+    printf("  [%d] %s (P:%d)\n", ph->root->task.id, ph->root->task.name, ph->root->task.priority);
+    for (const PairingNode* child = ph->root->child; child != NULL; child = child->sibling) {
+        printf("      |-- [%d] %s (P:%d), subtree of %d\n",
+               child->task.id, child->task.name, child->task.priority, subtreeSize(child));
+    }
+}
+
+// Free all pooled memory - Time Complexity: O(chunks)
+void freePairingHeap(PairingHeap* ph) {
+    PairingChunk* chunk = ph->chunks;
+    while (chunk != NULL) {
+        PairingChunk* temp = chunk;
+        chunk = chunk->next;
+        free(temp);
+    }
+    initPairingHeap(ph);
+}
@@ -1,19 +1,19 @@
 #include "priority_queue.h"
+#include "heap_template.h"
 #include <stdio.h>
 #include <stdlib.h>
 
+// Max-heap by priority (earlier arrival first on ties), generated from the shared heap template;
+// every task keeps its current slot in heapIndex
+#define TASK_BEFORE(a, b) ((a)->priority > (b)->priority || \
+                           ((a)->priority == (b)->priority && (a)->seq < (b)->seq))
+#define TASK_MOVED(task, index) ((task)->heapIndex = (index))
+DEFINE_TRACKED_HEAP(taskHeap, Task*, TASK_BEFORE, TASK_MOVED)
+
 // Helper functions for heap navigation
-static int parent(int i) { return (i - 1) / 2; }
 static int leftChild(int i) { return 2 * i + 1; }
 static int rightChild(int i) { return 2 * i + 2; }
 
-// Swap two tasks in heap - Time Complexity: O(1)
-static void swapTasks(Task** a, Task** b) {
-    Task* temp = *a;
-    *a = *b;
-    *b = temp;
-}
-
 // Initialize priority queue
 void initPriorityQueue(PriorityQueue* pq, int capacity) {
     pq->heap = (Task**)malloc(capacity * sizeof(Task*));
@@ -21,36 +21,6 @@ void initPriorityQueue(PriorityQueue* pq, int capacity) {
     pq->size = 0;
 }
 
-// Heapify up - restore heap property after insertion - Time Complexity: O(log n)
-static void heapifyUp(PriorityQueue* pq, int index) {
-    // Max heap: parent should have higher priority than children
-    while (index > 0 && pq->heap[parent(index)]->priority < pq->heap[index]->priority) {
-        swapTasks(&pq->heap[index], &pq->heap[parent(index)]);
-        index = parent(index);
-    }
-}
-
-// Heapify down - restore heap property after extraction - Time Complexity: O(log n)
-static void heapifyDown(PriorityQueue* pq, int index) {
-    int maxIndex = index;
-    int left = leftChild(index);
-    int right = rightChild(index);
-    
-    // Find largest priority among node and its children
-    if (left < pq->size && pq->heap[left]->priority > pq->heap[maxIndex]->priority) {
-        maxIndex = left;
-    }
-    if (right < pq->size && pq->heap[right]->priority > pq->heap[maxIndex]->priority) {
-        maxIndex = right;
-    }
-    
-    // If largest is not root, swap and continue heapifying
-    if (maxIndex != index) {
-        swapTasks(&pq->heap[index], &pq->heap[maxIndex]);
-        heapifyDown(pq, maxIndex);
-    }
-}
-
 // Resize heap when full - Time Complexity: O(n)
 static void resizeHeap(PriorityQueue* pq) {
     pq->capacity *= 2;
@@ -62,8 +32,8 @@ static void resizeHeap(PriorityQueue* pq) {
     pq->heap = newHeap;
 }
 
-// Insert task into priority queue - Time Complexity: O(log n)
-void insertPQ(PriorityQueue* pq, Task task) {
+// Insert task into priority queue - returns its heap entry - Time Complexity: O(log n)
+Task* insertPQ(PriorityQueue* pq, Task task) {
     if (pq->size == pq->capacity) {
         resizeHeap(pq);
     }
@@ -71,9 +41,26 @@ void insertPQ(PriorityQueue* pq, Task task) {
     // Create new task on heap and insert
     Task* newTask = (Task*)malloc(sizeof(Task));
     *newTask = task;
-    pq->heap[pq->size] = newTask;
-    heapifyUp(pq, pq->size);
-    pq->size++;
+    taskHeapPush(pq->heap, &pq->size, newTask);
+    return newTask;
+}
+
+// Add a task without restoring heap order - returns its heap entry - Time Complexity: O(1) amortized
+// Used for bulk loads; heapifyPQ must run before any other operation on the queue
+Task* appendPQ(PriorityQueue* pq, Task task) {
+    if (pq->size == pq->capacity) {
+        resizeHeap(pq);
+    }
+    
+    Task* newTask = (Task*)malloc(sizeof(Task));
+    *newTask = task;
+    pq->heap[pq->size++] = newTask;
+    return newTask;
+}
+
+// Restore heap order after appendPQ calls - Time Complexity: O(n)
+void heapifyPQ(PriorityQueue* pq) {
+    taskHeapBuild(pq->heap, pq->size);
 }
 
 // Extract maximum priority task - Time Complexity: O(log n)
@@ -84,16 +71,10 @@ Task extractMax(PriorityQueue* pq) {
         return emptyTask;
     }
     
-    Task maxTask = *(pq->heap[0]);
-    free(pq->heap[0]);  // Free the extracted task
-    
-    // Move last element to root and heapify down
-    pq->heap[0] = pq->heap[pq->size - 1];
-    pq->size--;
-    
-    if (pq->size > 0) {
-        heapifyDown(pq, 0);
-    }
+    // Move last element to root and sift it down
+    Task* root = taskHeapPopRoot(pq->heap, &pq->size);
+    Task maxTask = *root;
+    free(root);  // Free the extracted task
     
     return maxTask;
 }
@@ -146,32 +127,33 @@ void displayPQ(const PriorityQueue* pq) {
     }
 }
 
-// Remove task by ID from priority queue - Time Complexity: O(n)
-int removeFromPQ(PriorityQueue* pq, int id) {
-    // Find task in heap
-    int index = -1;
+// Remove an entry returned by insertPQ, copying it to removed if given - Time Complexity: O(log n)
+void removeEntryFromPQ(PriorityQueue* pq, Task* entry, Task* removed) {
+    taskHeapRemoveAt(pq->heap, &pq->size, entry->heapIndex);
+    if (removed != NULL) *removed = *entry;
+    free(entry);
+}
+
+// Remove every task matching predicate, then rebuild the heap once - Time Complexity: O(n)
+int removeWhereFromPQ(PriorityQueue* pq, TaskPredicate predicate, const void* ctx,
+                      TaskVisitor onRemoved, void* visitorCtx) {
+    int kept = 0;
     for (int i = 0; i < pq->size; i++) {
-        if (pq->heap[i]->id == id) {
-            index = i;
-            break;
+        Task* task = pq->heap[i];
+        if (predicate(task, ctx)) {
+            if (onRemoved != NULL) onRemoved(task, visitorCtx);
+            free(task);
+        } else {
+            pq->heap[kept++] = task;
         }
     }
     
-    if (index == -1) return 0;
-    
-    free(pq->heap[index]);  // Free the task
-    
-    // Replace with last element
-    pq->heap[index] = pq->heap[pq->size - 1];
-    pq->size--;
-    
-    if (pq->size > 0 && index < pq->size) {
-        // Restore heap property
-        heapifyDown(pq, index);
-        heapifyUp(pq, index);
+    int removed = pq->size - kept;
+    pq->size = kept;
+    if (removed > 0) {
+        taskHeapBuild(pq->heap, pq->size);  // Bottom-up heapify
     }
-    
-    return 1;
+    return removed;
 }
 
 // Free all memory used by priority queue - Time Complexity: O(n)
@@ -9,11 +9,12 @@ void initQueue(TaskQueue* queue) {
     queue->count = 0;
 }
 
-// Add task to rear of queue - Time Complexity: O(1)
-void enqueue(TaskQueue* queue, Task task) {
+// Add task to rear of queue - returns its node - Time Complexity: O(1)
+QueueNode* enqueue(TaskQueue* queue, Task task) {
     QueueNode* newNode = (QueueNode*)malloc(sizeof(QueueNode));
     newNode->task = task;
     newNode->next = NULL;
+    newNode->prev = queue->rear;
     
     if (queue->rear == NULL) {
         // Queue is empty
@@ -24,6 +25,7 @@ void enqueue(TaskQueue* queue, Task task) {
         queue->rear = newNode;
     }
     queue->count++;
+    return newNode;
 }
 
 // Remove task from front of queue - Time Complexity: O(1)
@@ -40,6 +42,8 @@ Task dequeue(TaskQueue* queue) {
     
     if (queue->front == NULL) {
         queue->rear = NULL;  // Queue is now empty
+    } else {
+        queue->front->prev = NULL;
     }
     
     free(temp);
@@ -73,34 +77,48 @@ void displayQueue(const TaskQueue* queue) {
     }
 }
 
-// Remove task by ID from queue - Time Complexity: O(n)
-int removeFromQueue(TaskQueue* queue, int id) {
-    if (queue->front == NULL) return 0;
-    
-    // Special case: removing front element
-    if (queue->front->task.id == id) {
-        QueueNode* temp = queue->front;
-        queue->front = queue->front->next;
-        if (queue->front == NULL) queue->rear = NULL;
-        free(temp);
-        queue->count--;
-        return 1;
+// Unlink a node obtained from enqueue, copying its task to removed if given - Time Complexity: O(1)
+void removeNodeFromQueue(TaskQueue* queue, QueueNode* node, Task* removed) {
+    if (node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        queue->front = node->next;
+    }
+    if (node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        queue->rear = node->prev;
     }
     
-    // Search for task
-    QueueNode* current = queue->front;
-    while (current->next != NULL) {
-        if (current->next->task.id == id) {
-            QueueNode* temp = current->next;
-            current->next = temp->next;
-            if (temp == queue->rear) queue->rear = current;
-            free(temp);
-            queue->count--;
-            return 1;
+    if (removed != NULL) *removed = node->task;
+    free(node);
+    queue->count--;
+}
+
+// Remove every task matching predicate in one traversal - Time Complexity: O(n)
+int removeWhereFromQueue(TaskQueue* queue, TaskPredicate predicate, const void* ctx,
+                         TaskVisitor onRemoved, void* visitorCtx) {
+    QueueNode** link = &queue->front;
+    QueueNode* last = NULL;
+    int removed = 0;
+    
+    while (*link != NULL) {
+        QueueNode* node = *link;
+        if (predicate(&node->task, ctx)) {
+            *link = node->next;  // Unlink and keep the same link for the successor
+            if (node->next != NULL) node->next->prev = last;
+            if (onRemoved != NULL) onRemoved(&node->task, visitorCtx);
+            free(node);
+            removed++;
+        } else {
+            last = node;
+            link = &node->next;
         }
-        current = current->next;
     }
-    return 0;
+    
+    queue->rear = last;
+    queue->count -= removed;
+    return removed;
 }
 
 // Free all memory used by queue - Time Complexity: O(n)
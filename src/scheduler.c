@@ -1,16 +1,521 @@
 #include "scheduler.h"
+#include "task_io.h"
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 // Initialize scheduler
 void initScheduler(TaskScheduler* scheduler) {
     initQueue(&scheduler->readyQueue);
     initPriorityQueue(&scheduler->priorityQueue, 10);
+    initPairingHeap(&scheduler->pairingQueue);
+    initPairingHeap(&scheduler->pairingBacklog);
+    scheduler->priorityBackend = HEAP_ARRAY;
+    initFairQueue(&scheduler->fairQueue);
     initHistory(&scheduler->history);
     scheduler->mode = FIFO;
     scheduler->nextTaskId = 1;
     scheduler->runningTask = NULL;
+    scheduler->stats.submitted = 0;
+    scheduler->stats.completed = 0;
+    scheduler->stats.cancelled = 0;
+    scheduler->stats.resumed = 0;
+    scheduler->stats.rejected = 0;
+    scheduler->stats.blocked = 0;
+    scheduler->stats.evicted = 0;
+    scheduler->stats.shed = 0;
+    initOrderIndex(&scheduler->index);
+    scheduler->nextSeq = 1;
+    scheduler->admission.capacity = 0;
+    scheduler->admission.highWatermark = 0;
+    scheduler->admission.lowWatermark = 0;
+    scheduler->admission.policy = ADMIT_REJECT;
+    scheduler->shedding = 0;
+}
+
+// Set admission limits; watermarks are clamped so that low <= high <= capacity
+void configureAdmission(TaskScheduler* scheduler, AdmissionConfig config) {
+    if (config.capacity < 0) config.capacity = 0;
+    if (config.capacity > 0 && config.highWatermark > config.capacity) {
+        config.highWatermark = config.capacity;
+    }
+    if (config.highWatermark < 0) config.highWatermark = 0;
+    if (config.lowWatermark > config.highWatermark) config.lowWatermark = config.highWatermark;
+    if (config.lowWatermark < 0) config.lowWatermark = 0;
+    scheduler->admission = config;
+    scheduler->shedding = 0;
+}
+
+// Choose the heap behind PRIORITY mode - returns 0 (no change) while tasks are queued
+int setPriorityBackend(TaskScheduler* scheduler, PriorityBackend backend) {
+    if (queuedCount(scheduler) > 0) return 0;
+    scheduler->priorityBackend = backend;
+    return 1;
+}
+
+// Move the ID counter past an ID taken from outside, such as an imported task
+void reserveTaskId(TaskScheduler* scheduler, int id) {
+    if (id >= scheduler->nextTaskId) scheduler->nextTaskId = id == INT_MAX ? 1 : id + 1;
+}
+
+// Hand out the next task ID. The counter wraps back to 1 instead of running
+// past INT_MAX, and IDs of tasks still queued are skipped - Time Complexity: O(1)
+static int takeTaskId(TaskScheduler* scheduler) {
+    for (;;) {
+        int id = scheduler->nextTaskId;
+        scheduler->nextTaskId = id == INT_MAX ? 1 : id + 1;
+        if (findInIndex(&scheduler->index, id) == NULL) return id;
+    }
+}
+
+// Place a task on the ready structure for the current mode, bypassing admission control
+void enqueueTask(TaskScheduler* scheduler, Task task) {
+    Task* entry;
+    task.seq = scheduler->nextSeq++;
+    switch (scheduler->mode) {
+        case FIFO:
+            entry = &enqueue(&scheduler->readyQueue, task)->task;
+            break;
+        case FAIR_SHARE:
+            entry = &enqueueFair(&scheduler->fairQueue, task)->task;
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                entry = &insertPairing(&scheduler->pairingQueue, task)->task;
+            } else {
+                entry = insertPQ(&scheduler->priorityQueue, task);
+            }
+            break;
+    }
+    insertIndex(&scheduler->index, entry);
+}
+
+// Queue a task from a bulk load, keeping its ID; the caller enforces any queue limit.
+// The order index and, in PRIORITY mode, heap order catch up in finishBulkLoad,
+// which must run before any other operation - Time Complexity: O(1) (FIFO, PRIORITY)
+void bulkLoadTask(TaskScheduler* scheduler, Task task) {
+    Task* entry;
+    task.seq = scheduler->nextSeq++;
+    task.status = READY;
+    task.heapIndex = -1;
+    task.coroutine = NULL;
+    switch (scheduler->mode) {
+        case FIFO:
+            entry = &enqueue(&scheduler->readyQueue, task)->task;
+            break;
+        case FAIR_SHARE:
+            entry = &enqueueFair(&scheduler->fairQueue, task)->task;
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                entry = &insertPairing(&scheduler->pairingBacklog, task)->task;
+            } else {
+                entry = appendPQ(&scheduler->priorityQueue, task);
+            }
+            break;
+    }
+    stageIndex(&scheduler->index, entry);
+    reserveTaskId(scheduler, task.id);
+}
+
+// End a bulk load started by bulkLoadTask calls - Time Complexity: O(n + k log k)
+void finishBulkLoad(TaskScheduler* scheduler) {
+    mergeStagedIndex(&scheduler->index);
+    if (scheduler->mode == PRIORITY) {
+        if (scheduler->priorityBackend == HEAP_PAIRING) {
+            meldPQ(&scheduler->pairingQueue, &scheduler->pairingBacklog);  // O(1)
+        } else {
+            heapifyPQ(&scheduler->priorityQueue);
+        }
+    }
+}
+
+// Queue node whose task an index entry points at
+static QueueNode* queueNodeOf(Task* task) {
+    return (QueueNode*)((char*)task - offsetof(QueueNode, task));
+}
+
+// Pairing heap node whose task an index entry points at
+static PairingNode* pairingNodeOf(Task* task) {
+    return (PairingNode*)((char*)task - offsetof(PairingNode, task));
+}
+
+// Take an indexed task out of its queue - Time Complexity: O(log n)
+static void removeQueuedEntry(TaskScheduler* scheduler, IndexNode* node, Task* removed) {
+    switch (scheduler->mode) {
+        case FIFO:
+            removeNodeFromQueue(&scheduler->readyQueue, queueNodeOf(node->task), removed);
+            break;
+        case FAIR_SHARE:
+            removeNodeFromFair(&scheduler->fairQueue, queueNodeOf(node->task), removed);
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                removeNodeFromPairing(&scheduler->pairingQueue, pairingNodeOf(node->task), removed);
+            } else {
+                removeEntryFromPQ(&scheduler->priorityQueue, node->task, removed);
+            }
+            break;
+    }
+    removeFromIndex(&scheduler->index, removed);  // Frees node
+}
+
+// Drop a task's execution state and give its stack back to the pool
+static void releaseCoroutine(Task* task) {
+    if (task->coroutine != NULL) {
+        destroyCoroutine(task->coroutine);
+        task->coroutine = NULL;
+    }
+}
+
+// Drop the lowest-priority (latest among equals) queued task into history
+static void evictLowest(TaskScheduler* scheduler) {
+    Task evicted;
+    removeQueuedEntry(scheduler, scheduler->index.tail, &evicted);
+    releaseCoroutine(&evicted);
+    evicted.status = REMOVED;
+    addToHistory(&scheduler->history, evicted);
+    scheduler->stats.evicted++;
+}
+
+// Decide whether a new task of this priority may be queued - returns 1 or a SUBMIT_* code
+int admitTask(TaskScheduler* scheduler, int priority) {
+    const AdmissionConfig* config = &scheduler->admission;
+    int queued = queuedCount(scheduler);
+    const IndexNode* lowest = scheduler->index.tail;
+    
+    // Between the watermarks only tasks that outrank the current minimum get in
+    if (config->highWatermark > 0) {
+        if (queued >= config->highWatermark) {
+            scheduler->shedding = 1;
+        } else if (queued <= config->lowWatermark) {
+            scheduler->shedding = 0;
+        }
+    }
+    if (scheduler->shedding && lowest != NULL && priority <= lowest->priority) {
+        scheduler->stats.shed++;
+        return SUBMIT_REJECTED;
+    }
+    
+    if (config->capacity == 0 || queued < config->capacity) return 1;
+    
+    switch (config->policy) {
+        case ADMIT_BLOCK:
+            // Counted in stats.blocked by the caller, once per submission it holds back
+            return SUBMIT_WOULD_BLOCK;
+        case ADMIT_EVICT_LOWEST:
+            if (lowest != NULL && priority > lowest->priority) {
+                evictLowest(scheduler);
+                return 1;
+            }
+            scheduler->stats.rejected++;
+            return SUBMIT_REJECTED;
+        case ADMIT_REJECT:
+        default:
+            scheduler->stats.rejected++;
+            return SUBMIT_REJECTED;
+    }
+}
+
+// Create a task with the next free ID and queue it - returns the new ID or a SUBMIT_* code
+int submitTask(TaskScheduler* scheduler, const char* name, int priority, int execTime) {
+    return submitTenantTask(scheduler, DEFAULT_TENANT, name, priority, execTime);
+}
+
+// Same as submitTask, charging the work to the given tenant under FAIR_SHARE
+int submitTenantTask(TaskScheduler* scheduler, int tenant, const char* name, int priority,
+                     int execTime) {
+    int verdict = admitTask(scheduler, priority);
+    if (verdict != 1) return verdict;
+    
+    Task newTask = createTask(takeTaskId(scheduler), name, priority, execTime);
+    newTask.tenant = tenant;
+    enqueueTask(scheduler, newTask);
+    scheduler->stats.submitted++;
+    return newTask.id;
+}
+
+// Queue a task whose body fn(arg) runs as a coroutine - returns the new ID,
+// a SUBMIT_* code, or 0 if no stack is free
+int submitCoroutineTask(TaskScheduler* scheduler, const char* name, int priority, int execTime,
+                        CoroutineFn fn, void* arg) {
+    // Take the stack first: admission may evict a queued task to make room
+    Coroutine* co = createCoroutine(fn, arg);
+    if (co == NULL) return 0;
+
+    int verdict = admitTask(scheduler, priority);
+    if (verdict != 1) {
+        destroyCoroutine(co);
+        return verdict;
+    }
+
+    Task newTask = createTask(takeTaskId(scheduler), name, priority, execTime);
+    newTask.coroutine = co;
+    enqueueTask(scheduler, newTask);
+    scheduler->stats.submitted++;
+    return newTask.id;
+}
+
+// Body of a stepped task: one simulated second of work per slice, yielding in between
+static void runSteps(void* arg) {
+    int steps = (int)(intptr_t)arg;
+    for (int step = 1; step < steps; step++) {
+        yieldCoroutine();
+    }
+}
+
+// Queue a coroutine task that needs one execution slice per step - returns as submitCoroutineTask
+int submitSteppedTask(TaskScheduler* scheduler, const char* name, int priority, int steps) {
+    if (steps < 1) steps = 1;
+    return submitCoroutineTask(scheduler, name, priority, steps, runSteps, (void*)(intptr_t)steps);
+}
+
+// Take the next task to run according to the mode - returns 0 if nothing is queued
+int dequeueNextTask(TaskScheduler* scheduler, Task* out) {
+    switch (scheduler->mode) {
+        case FIFO:
+            if (isQueueEmpty(&scheduler->readyQueue)) return 0;
+            *out = dequeue(&scheduler->readyQueue);
+            break;
+        case FAIR_SHARE:
+            if (isFairEmpty(&scheduler->fairQueue)) return 0;
+            *out = dequeueFair(&scheduler->fairQueue);
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                if (isPairingEmpty(&scheduler->pairingQueue)) return 0;
+                *out = extractMaxPairing(&scheduler->pairingQueue);
+                break;
+            }
+            if (isPQEmpty(&scheduler->priorityQueue)) return 0;
+            *out = extractMax(&scheduler->priorityQueue);
+            break;
+    }
+    removeFromIndex(&scheduler->index, out);
+    return 1;
+}
+
+// Take the queued task that would run last: the newest in FIFO, otherwise the
+// lowest priority (newest among equals) - returns 0 if nothing is queued
+// Time Complexity: O(log n)
+int takeLeastUrgentTask(TaskScheduler* scheduler, Task* out) {
+    IndexNode* node = scheduler->index.tail;
+    if (node == NULL) return 0;
+    if (scheduler->mode == FIFO) {
+        node = findInIndex(&scheduler->index, scheduler->readyQueue.rear->task.id);
+    }
+    removeQueuedEntry(scheduler, node, out);
+    return 1;
+}
+
+// Run the next task to completion without any console output
+int completeNextTask(TaskScheduler* scheduler, Task* out) {
+    Task task;
+    if (scheduler->runningTask != NULL || !dequeueNextTask(scheduler, &task)) {
+        return 0;
+    }
+    // Coroutine tasks are driven through every yield until their body returns
+    while (resumeCoroutine(task.coroutine));
+    releaseCoroutine(&task);
+    task.status = COMPLETED;
+    addToHistory(&scheduler->history, task);
+    scheduler->stats.completed++;
+    if (out != NULL) *out = task;
+    return 1;
+}
+
+// Cancel a running or queued task by ID - returns 0 if not found - Time Complexity: O(log n)
+int cancelTask(TaskScheduler* scheduler, int id) {
+    // Check if it's the running task
+    if (scheduler->runningTask != NULL && scheduler->runningTask->id == id) {
+        releaseCoroutine(scheduler->runningTask);
+        scheduler->runningTask->status = REMOVED;
+        addToHistory(&scheduler->history, *(scheduler->runningTask));
+        free(scheduler->runningTask);
+        scheduler->runningTask = NULL;
+        scheduler->stats.cancelled++;
+        return 1;
+    }
+
+    // Locate the queued entry through the index
+    IndexNode* node = findInIndex(&scheduler->index, id);
+    if (node == NULL) return 0;
+
+    Task cancelled;
+    removeQueuedEntry(scheduler, node, &cancelled);
+    releaseCoroutine(&cancelled);
+    cancelled.status = REMOVED;
+    addToHistory(&scheduler->history, cancelled);
+    scheduler->stats.cancelled++;
+    return 1;
+}
+
+// Hold a running or queued task as PAUSED in history - returns 0 if not found.
+// A coroutine task keeps its execution state until it is resumed.
+int pauseTaskById(TaskScheduler* scheduler, int id) {
+    Task paused;
+    if (scheduler->runningTask != NULL && scheduler->runningTask->id == id) {
+        paused = *(scheduler->runningTask);
+        free(scheduler->runningTask);
+        scheduler->runningTask = NULL;
+    } else {
+        IndexNode* node = findInIndex(&scheduler->index, id);
+        if (node == NULL) return 0;
+        removeQueuedEntry(scheduler, node, &paused);
+    }
+    paused.status = PAUSED;
+    addToHistory(&scheduler->history, paused);
+    return 1;
+}
+
+// Change a queued task's priority, moving it in its heap and in the order
+// index - returns 0 if the task is not queued. Raising a task under
+// HEAP_PAIRING is O(1) in the heap; every other change is O(log n).
+int reprioritizeTask(TaskScheduler* scheduler, int id, int priority) {
+    IndexNode* node = findInIndex(&scheduler->index, id);
+    if (node == NULL) return 0;
+    Task* entry = node->task;
+
+    // The index is keyed on the old priority, so the entry leaves it first
+    removeFromIndex(&scheduler->index, entry);  // Frees node
+    if (scheduler->mode != PRIORITY) {
+        entry->priority = priority;  // FIFO and tenant queues keep arrival order
+    } else if (scheduler->priorityBackend == HEAP_PAIRING && priority >= entry->priority) {
+        increaseKeyPairing(&scheduler->pairingQueue, pairingNodeOf(entry), priority);
+    } else {
+        Task task;
+        if (scheduler->priorityBackend == HEAP_PAIRING) {
+            removeNodeFromPairing(&scheduler->pairingQueue, pairingNodeOf(entry), &task);
+            task.priority = priority;
+            entry = &insertPairing(&scheduler->pairingQueue, task)->task;
+        } else {
+            removeEntryFromPQ(&scheduler->priorityQueue, entry, &task);
+            task.priority = priority;
+            entry = insertPQ(&scheduler->priorityQueue, task);
+        }
+    }
+    insertIndex(&scheduler->index, entry);
+    return 1;
+}
+
+// Record one task dropped by removeWhere
+static void recordCancelled(Task* task, void* ctx) {
+    TaskScheduler* scheduler = (TaskScheduler*)ctx;
+    removeFromIndex(&scheduler->index, task);
+    releaseCoroutine(task);
+    task->status = REMOVED;
+    addToHistory(&scheduler->history, *task);
+    scheduler->stats.cancelled++;
+}
+
+// Cancel every running or queued task matching predicate - Time Complexity: O(n + k log n)
+int removeWhere(TaskScheduler* scheduler, TaskPredicate predicate, const void* ctx) {
+    int removed = 0;
+    
+    if (scheduler->runningTask != NULL && predicate(scheduler->runningTask, ctx)) {
+        recordCancelled(scheduler->runningTask, scheduler);
+        free(scheduler->runningTask);
+        scheduler->runningTask = NULL;
+        removed++;
+    }
+    
+    switch (scheduler->mode) {
+        case FIFO:
+            removed += removeWhereFromQueue(&scheduler->readyQueue, predicate, ctx,
+                                            recordCancelled, scheduler);
+            break;
+        case FAIR_SHARE:
+            removed += removeWhereFromFair(&scheduler->fairQueue, predicate, ctx,
+                                           recordCancelled, scheduler);
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                removed += removeWhereFromPairing(&scheduler->pairingQueue, predicate, ctx,
+                                                  recordCancelled, scheduler);
+                break;
+            }
+            removed += removeWhereFromPQ(&scheduler->priorityQueue, predicate, ctx,
+                                         recordCancelled, scheduler);
+            break;
+    }
+    return removed;
+}
+
+// TaskPredicate for a TaskFilter
+int matchTaskFilter(const Task* task, const void* filter) {
+    const TaskFilter* f = (const TaskFilter*)filter;
+    switch (f->kind) {
+        case FILTER_NAME_PREFIX:
+            return strncmp(task->name, f->prefix, strlen(f->prefix)) == 0;
+        case FILTER_PRIORITY_RANGE:
+            return task->priority >= f->low && task->priority <= f->high;
+        case FILTER_ID_RANGE:
+            return task->id >= f->low && task->id <= f->high;
+        default:
+            return 0;
+    }
+}
+
+// Put a paused task back on the ready queue - returns 0 if no such paused task
+// or a task with the same ID is already queued. Resumed work was admitted once
+// already, so admission control is not applied.
+int resumeTaskById(TaskScheduler* scheduler, int id) {
+    if (findInIndex(&scheduler->index, id) != NULL) return 0;
+    Task* pausedTask = findPausedTask(&scheduler->history, id);
+    if (pausedTask == NULL) return 0;
+
+    Task resumedTask = *pausedTask;
+    resumedTask.status = READY;
+    // The queued copy now owns the execution state; the record cannot be resumed twice
+    pausedTask->status = RESUMED;
+    pausedTask->coroutine = NULL;
+    enqueueTask(scheduler, resumedTask);
+    scheduler->stats.resumed++;
+    return 1;
+}
+
+// Number of tasks waiting in the active ready structure - Time Complexity: O(1)
+int queuedCount(const TaskScheduler* scheduler) {
+    return scheduler->index.count;
+}
+
+// Short name of a scheduling mode
+const char* modeToString(SchedulingMode mode) {
+    switch (mode) {
+        case FIFO: return "FIFO";
+        case PRIORITY: return "PRIORITY";
+        case FAIR_SHARE: return "FAIR_SHARE";
+        default: return "UNKNOWN";
+    }
+}
+
+// Display the ready structure of the current mode
+static void displayReady(const TaskScheduler* scheduler) {
+    switch (scheduler->mode) {
+        case FIFO:
+            displayQueue(&scheduler->readyQueue);
+            break;
+        case FAIR_SHARE:
+            displayFairQueue(&scheduler->fairQueue);
+            break;
+        case PRIORITY:
+        default:
+            if (scheduler->priorityBackend == HEAP_PAIRING) {
+                displayPairingHeap(&scheduler->pairingQueue);
+            } else {
+                displayPQ(&scheduler->priorityQueue);
+            }
+            break;
+    }
 }
 
 // Display header
@@ -21,7 +526,8 @@ static void displayHeader(const TaskScheduler* scheduler) {
     printf("  ==================================================\n");
     printf("  Current Mode: %s\n", 
            scheduler->mode == FIFO ? "FIFO (First In First Out)" : 
-                                    "PRIORITY (Highest Priority First)");
+           scheduler->mode == PRIORITY ? "PRIORITY (Highest Priority First)" :
+                                         "FAIR_SHARE (Weighted Fair Across Tenants)");
     printf("  ==================================================\n\n");
 }
 
@@ -29,6 +535,7 @@ static void displayHeader(const TaskScheduler* scheduler) {
 void addTask(TaskScheduler* scheduler) {
     char name[100];
     int priority, execTime;
+    int tenant = DEFAULT_TENANT;
     
     printf("\n  ADD NEW TASK\n");
     printf("  ------------------------------\n");
@@ -44,28 +551,99 @@ void addTask(TaskScheduler* scheduler) {
     printf("  Enter execution time (seconds): ");
     scanf("%d", &execTime);
     
-    Task newTask = createTask(scheduler->nextTaskId++, name, priority, execTime);
+    if (scheduler->mode == FAIR_SHARE) {
+        printf("  Enter tenant ID: ");
+        scanf("%d", &tenant);
+    }
+    
+    int id = submitTenantTask(scheduler, tenant, name, priority, execTime);
     
-    // Add to appropriate queue based on mode
-    if (scheduler->mode == FIFO) {
-        enqueue(&scheduler->readyQueue, newTask);
-    } else {
-        insertPQ(&scheduler->priorityQueue, newTask);
+    if (id == SUBMIT_REJECTED) {
+        printf("\n  Warning: Task rejected by admission control (queue overloaded).\n");
+        return;
+    }
+    if (id == SUBMIT_WOULD_BLOCK) {
+        scheduler->stats.blocked++;
+        printf("\n  Warning: Queue is full. Execute some tasks and try again.\n");
+        return;
     }
     
-    printf("\n  Task added successfully with ID: %d\n", newTask.id);
+    printf("\n  Task added successfully with ID: %d\n", id);
     
     // Display updated queue
     printf("\n  Updated Ready Queue:\n");
-    if (scheduler->mode == FIFO) {
-        displayQueue(&scheduler->readyQueue);
-    } else {
-        displayPQ(&scheduler->priorityQueue);
+    displayReady(scheduler);
+}
+
+// Add a task that runs as a coroutine, one execution slice per step
+void addSteppedTask(TaskScheduler* scheduler) {
+    char name[100];
+    int priority, steps;
+    
+    printf("\n  ADD STEPPED TASK\n");
+    printf("  ------------------------------\n");
+    
+    printf("  Enter task name: ");
+    getchar();  // Clear newline
+    fgets(name, 100, stdin);
+    name[strcspn(name, "\n")] = 0;  // Remove newline
+    
+    printf("  Enter priority (higher = more important): ");
+    scanf("%d", &priority);
+    
+    printf("  Enter number of steps: ");
+    scanf("%d", &steps);
+    
+    int id = submitSteppedTask(scheduler, name, priority, steps);
+    
+    if (id == SUBMIT_REJECTED) {
+        printf("\n  Warning: Task rejected by admission control (queue overloaded).\n");
+        return;
+    }
+    if (id == SUBMIT_WOULD_BLOCK) {
+        scheduler->stats.blocked++;
+        printf("\n  Warning: Queue is full. Execute some tasks and try again.\n");
+        return;
+    }
+    if (id == 0) {
+        printf("\n  Warning: No coroutine stack available!\n");
+        return;
+    }
+    
+    printf("\n  Stepped task added with ID: %d\n", id);
+    printf("  Each Execute runs one step; Pause and Resume keep its progress.\n");
+}
+
+// Run the current coroutine task until it yields or returns
+static void runCoroutineSlice(TaskScheduler* scheduler) {
+    printf("\n  Running task code...\n");
+    
+    if (resumeCoroutine(scheduler->runningTask->coroutine)) {
+        printf("\n  Task yielded and is still RUNNING.\n");
+        printf("  Execute again to continue it, or pause it to keep its state.\n");
+        return;
     }
+    
+    releaseCoroutine(scheduler->runningTask);
+    scheduler->runningTask->status = COMPLETED;
+    addToHistory(&scheduler->history, *(scheduler->runningTask));
+    scheduler->stats.completed++;
+    
+    printf("\n  Task completed and moved to history!\n");
+    
+    free(scheduler->runningTask);
+    scheduler->runningTask = NULL;
 }
 
 // Execute next task
 void executeNextTask(TaskScheduler* scheduler) {
+    if (scheduler->runningTask != NULL && scheduler->runningTask->coroutine != NULL) {
+        printf("\n  CONTINUING TASK [%d] %s\n",
+               scheduler->runningTask->id, scheduler->runningTask->name);
+        runCoroutineSlice(scheduler);
+        return;
+    }
+    
     if (scheduler->runningTask != NULL) {
         printf("\n  Warning: A task is already running: [%d] %s\n", 
                scheduler->runningTask->id, scheduler->runningTask->name);
@@ -75,18 +653,11 @@ void executeNextTask(TaskScheduler* scheduler) {
     
     Task taskToExecute;
     
-    if (scheduler->mode == FIFO) {
-        if (isQueueEmpty(&scheduler->readyQueue)) {
-            printf("\n  Warning: No tasks in ready queue!\n");
-            return;
-        }
-        taskToExecute = dequeue(&scheduler->readyQueue);
-    } else {
-        if (isPQEmpty(&scheduler->priorityQueue)) {
-            printf("\n  Warning: No tasks in priority queue!\n");
-            return;
-        }
-        taskToExecute = extractMax(&scheduler->priorityQueue);
+    if (!dequeueNextTask(scheduler, &taskToExecute)) {
+        printf("\n  Warning: No tasks in %s queue!\n",
+               scheduler->mode == FIFO ? "ready" :
+               scheduler->mode == PRIORITY ? "priority" : "any tenant's");
+        return;
     }
     
     taskToExecute.status = RUNNING;
@@ -101,12 +672,18 @@ void executeNextTask(TaskScheduler* scheduler) {
     printf("  Execution Time: %d seconds\n", scheduler->runningTask->executionTime);
     printf("  Status: %s\n", statusToString(scheduler->runningTask->status));
     
+    if (scheduler->runningTask->coroutine != NULL) {
+        runCoroutineSlice(scheduler);
+        return;
+    }
+    
     // Simulate execution
     printf("\n  Simulating execution...\n");
     
     // Mark as completed
     scheduler->runningTask->status = COMPLETED;
     addToHistory(&scheduler->history, *(scheduler->runningTask));
+    scheduler->stats.completed++;
     
     printf("\n  Task completed and moved to history!\n");
     
@@ -140,22 +717,12 @@ void resumeTask(TaskScheduler* scheduler) {
     scanf("%d", &id);
     
     Task* pausedTask = findPausedTask(&scheduler->history, id);
-    if (pausedTask == NULL) {
+    if (pausedTask == NULL || !resumeTaskById(scheduler, id)) {
         printf("\n  Warning: No paused task found with ID: %d\n", id);
         return;
     }
     
-    Task resumedTask = *pausedTask;
-    resumedTask.status = READY;
-    
-    // Add back to appropriate queue
-    if (scheduler->mode == FIFO) {
-        enqueue(&scheduler->readyQueue, resumedTask);
-    } else {
-        insertPQ(&scheduler->priorityQueue, resumedTask);
-    }
-    
-    printf("\n  Task resumed: [%d] %s\n", resumedTask.id, resumedTask.name);
+    printf("\n  Task resumed: [%d] %s\n", pausedTask->id, pausedTask->name);
     printf("  Task added back to ready queue.\n");
 }
 
@@ -165,33 +732,121 @@ void removeTask(TaskScheduler* scheduler) {
     printf("\n  Enter task ID to remove: ");
     scanf("%d", &id);
     
-    int found = 0;
+    int wasRunning = scheduler->runningTask != NULL && scheduler->runningTask->id == id;
     
-    // Check if it's the running task
-    if (scheduler->runningTask != NULL && scheduler->runningTask->id == id) {
-        scheduler->runningTask->status = REMOVED;
-        addToHistory(&scheduler->history, *(scheduler->runningTask));
-        free(scheduler->runningTask);
-        scheduler->runningTask = NULL;
-        found = 1;
+    if (!cancelTask(scheduler, id)) {
+        printf("\n  Warning: Task with ID %d not found.\n", id);
+    } else if (wasRunning) {
         printf("\n  Running task removed and moved to history.\n");
-        return;
+    } else {
+        printf("\n  Task removed from queue and moved to history.\n");
     }
+}
+
+// Cancel all tasks matching a name prefix, priority range or ID range
+void bulkRemoveTasks(TaskScheduler* scheduler) {
+    int choice;
+    char prefix[100];
+    TaskFilter filter;
     
-    // Try to remove from queue
-    if (scheduler->mode == FIFO) {
-        found = removeFromQueue(&scheduler->readyQueue, id);
+    printf("\n  BULK REMOVE TASKS\n");
+    printf("  ------------------------------\n");
+    printf("  1. By name prefix\n");
+    printf("  2. By priority range\n");
+    printf("  3. By ID range\n");
+    printf("  Enter choice: ");
+    if (scanf("%d", &choice) != 1) choice = 0;
+    
+    if (choice == 1) {
+        printf("  Enter name prefix: ");
+        getchar();  // Clear newline
+        fgets(prefix, 100, stdin);
+        prefix[strcspn(prefix, "\n")] = 0;  // Remove newline
+        filter.kind = FILTER_NAME_PREFIX;
+        filter.prefix = prefix;
+    } else if (choice == 2 || choice == 3) {
+        filter.kind = choice == 2 ? FILTER_PRIORITY_RANGE : FILTER_ID_RANGE;
+        printf("  Enter lowest %s: ", choice == 2 ? "priority" : "ID");
+        scanf("%d", &filter.low);
+        printf("  Enter highest %s: ", choice == 2 ? "priority" : "ID");
+        scanf("%d", &filter.high);
     } else {
-        found = removeFromPQ(&scheduler->priorityQueue, id);
+        printf("\n  Warning: Invalid choice!\n");
+        return;
     }
     
-    if (found) {
-        Task removedTask = createTask(id, "Removed Task", 0, 0);
-        removedTask.status = REMOVED;
-        addToHistory(&scheduler->history, removedTask);
-        printf("\n  Task removed from queue and moved to history.\n");
+    int removed = removeWhere(scheduler, matchTaskFilter, &filter);
+    printf("\n  %d task(s) removed and moved to history.\n", removed);
+}
+
+// Give a tenant a larger or smaller share under FAIR_SHARE
+void setTenantWeightMenu(TaskScheduler* scheduler) {
+    int tenant, weight;
+    printf("\n  Enter tenant ID: ");
+    scanf("%d", &tenant);
+    printf("  Enter weight (share relative to weight %d): ", DEFAULT_TENANT_WEIGHT);
+    scanf("%d", &weight);
+    
+    if (weight < 1) {
+        printf("\n  Warning: Weight must be at least 1.\n");
+        return;
+    }
+    setTenantWeight(&scheduler->fairQueue, tenant, weight);
+    printf("\n  Tenant %d now has weight %d.\n", tenant, weight);
+}
+
+static double elapsedSeconds(const struct timespec* start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start->tv_sec) + (now.tv_nsec - start->tv_nsec) / 1e9;
+}
+
+// Load or save a whole task set in one step
+void importExportTasks(TaskScheduler* scheduler) {
+    int choice;
+    char path[256];
+
+    printf("\n  IMPORT / EXPORT TASKS\n");
+    printf("  ------------------------------\n");
+    printf("  1. Import from file (binary or CSV)\n");
+    printf("  2. Export to binary file\n");
+    printf("  3. Export to CSV file\n");
+    printf("  Enter choice: ");
+    if (scanf("%d", &choice) != 1 || choice < 1 || choice > 3) {
+        printf("\n  Warning: Invalid choice!\n");
+        return;
+    }
+
+    printf("  Enter file path: ");
+    getchar();  // Clear newline
+    fgets(path, sizeof(path), stdin);
+    path[strcspn(path, "\n")] = 0;  // Remove newline
+
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    long count;
+    long errorLine = 0;
+    int full = 0;
+    if (choice == 1) {
+        count = importTasks(scheduler, path, &errorLine, &full);
     } else {
-        printf("\n  Warning: Task with ID %d not found.\n", id);
+        count = exportTasks(scheduler, path, choice == 2 ? TASKFILE_BINARY : TASKFILE_CSV);
+    }
+    double seconds = elapsedSeconds(&start);
+
+    if (count < 0) {
+        printf("\n  Warning: Could not %s '%s'.\n", choice == 1 ? "import" : "write", path);
+        return;
+    }
+    printf("\n  %ld task(s) %s in %.3f seconds (%.0f tasks/sec).\n",
+           count, choice == 1 ? "imported" : "exported", seconds,
+           seconds > 0 ? count / seconds : 0.0);
+    if (errorLine > 0) {
+        printf("  Warning: Stopped at malformed entry %ld.\n", errorLine);
+    }
+    if (full) {
+        printf("  Warning: Stopped once the queue reached its admission limit.\n");
     }
 }
 
@@ -211,13 +866,29 @@ void displayAll(const TaskScheduler* scheduler) {
         printf("\n  RUNNING TASK: None\n");
     }
     
-    printf("\n  READY QUEUE (%s Mode):\n", 
-           scheduler->mode == FIFO ? "FIFO" : "PRIORITY");
+    printf("\n  READY QUEUE (%s Mode):\n", modeToString(scheduler->mode));
     printf("  ------------------------------\n");
-    if (scheduler->mode == FIFO) {
-        displayQueue(&scheduler->readyQueue);
-    } else {
-        displayPQ(&scheduler->priorityQueue);
+    displayReady(scheduler);
+    
+    if (scheduler->fairQueue.tenantCount > 0) {
+        printf("\n  TENANT SHARES:\n");
+        printf("  ------------------------------\n");
+        displayTenantShares(&scheduler->fairQueue);
+    }
+    
+    const AdmissionConfig* admission = &scheduler->admission;
+    if (admission->capacity > 0 || admission->highWatermark > 0) {
+        printf("\n  ADMISSION CONTROL:\n");
+        printf("  ------------------------------\n");
+        printf("  Queued: %d / %d  Watermarks: %d-%d  Policy: %s%s\n",
+               queuedCount(scheduler), admission->capacity,
+               admission->lowWatermark, admission->highWatermark,
+               admission->policy == ADMIT_BLOCK ? "BLOCK" :
+               admission->policy == ADMIT_EVICT_LOWEST ? "EVICT LOWEST" : "REJECT",
+               scheduler->shedding ? "  [SHEDDING]" : "");
+        printf("  Rejected: %ld  Blocked: %ld  Evicted: %ld  Shed: %ld\n",
+               scheduler->stats.rejected, scheduler->stats.blocked,
+               scheduler->stats.evicted, scheduler->stats.shed);
     }
     
     printf("\n  TASK HISTORY (Completed/Paused/Removed):\n");
@@ -227,15 +898,69 @@ void displayAll(const TaskScheduler* scheduler) {
 
 // Switch scheduling mode
 void switchMode(TaskScheduler* scheduler) {
-    if (!isQueueEmpty(&scheduler->readyQueue) || !isPQEmpty(&scheduler->priorityQueue)) {
+    if (queuedCount(scheduler) > 0) {
         printf("\n  Warning: Cannot switch mode while tasks are in queue!\n");
         printf("  Please execute or remove all tasks first.\n");
         return;
     }
     
-    scheduler->mode = (scheduler->mode == FIFO) ? PRIORITY : FIFO;
-    printf("\n  Switched to %s mode.\n", 
-           scheduler->mode == FIFO ? "FIFO" : "PRIORITY");
+    scheduler->mode = scheduler->mode == FIFO ? PRIORITY :
+                      scheduler->mode == PRIORITY ? FAIR_SHARE : FIFO;
+    printf("\n  Switched to %s mode.\n", modeToString(scheduler->mode));
+}
+
+// Answer rank and priority-range questions from the order index
+void queryQueue(const TaskScheduler* scheduler) {
+    int choice;
+    printf("\n  QUERY QUEUE\n");
+    printf("  ------------------------------\n");
+    printf("  1. Count tasks above a priority\n");
+    printf("  2. Position of a task in priority order\n");
+    printf("  3. List tasks in a priority range\n");
+    printf("  Enter choice: ");
+    if (scanf("%d", &choice) != 1) choice = 0;
+    
+    if (choice == 1) {
+        int priority;
+        printf("  Enter priority: ");
+        scanf("%d", &priority);
+        printf("\n  %d of %d queued tasks have priority above %d.\n",
+               countAbovePriority(&scheduler->index, priority),
+               scheduler->index.count, priority);
+    } else if (choice == 2) {
+        int id;
+        printf("  Enter task ID: ");
+        scanf("%d", &id);
+        int rank = rankInIndex(&scheduler->index, id);
+        if (rank == 0) {
+            printf("\n  Warning: Task with ID %d is not queued.\n", id);
+        } else {
+            printf("\n  Task %d is number %d of %d by (priority, arrival).\n",
+                   id, rank, scheduler->index.count);
+        }
+    } else if (choice == 3) {
+        int low, high;
+        printf("  Enter lowest priority: ");
+        scanf("%d", &low);
+        printf("  Enter highest priority: ");
+        scanf("%d", &high);
+        
+        int count = countPriorityRange(&scheduler->index, low, high);
+        printf("\n  %d queued task(s) with priority %d..%d:\n", count, low, high);
+        if (count == 0) return;
+        
+        Task* tasks = (Task*)malloc(count * sizeof(Task));
+        listPriorityRange(&scheduler->index, low, high, tasks, count);
+        printf("  %-5s %-25s %-12s %-15s\n", "ID", "Name", "Priority", "Exec Time");
+        printf("  ---------------------------------------------------------\n");
+        for (int i = 0; i < count; i++) {
+            printf("  %-5d %-25s %-12d %-15ds\n",
+                   tasks[i].id, tasks[i].name, tasks[i].priority, tasks[i].executionTime);
+        }
+        free(tasks);
+    } else {
+        printf("\n  Warning: Invalid choice!\n");
+    }
 }
 
 // Main menu loop
@@ -254,7 +979,12 @@ void runScheduler(TaskScheduler* scheduler) {
         printf("  5. Remove Task by ID\n");
         printf("  6. Display All Queues & History\n");
         printf("  7. Switch Scheduling Mode\n");
-        printf("  8. Exit\n");
+        printf("  8. Query Queue (Rank / Range)\n");
+        printf("  9. Bulk Remove Tasks\n");
+        printf("  10. Set Tenant Weight\n");
+        printf("  11. Import / Export Tasks\n");
+        printf("  12. Add Stepped Task (Coroutine)\n");
+        printf("  13. Exit\n");
         printf("  ------------------------------\n");
         printf("  Enter choice: ");
         
@@ -289,19 +1019,29 @@ void runScheduler(TaskScheduler* scheduler) {
                 switchMode(scheduler);
                 break;
             case 8:
+                queryQueue(scheduler);
+                break;
+            case 9:
+                bulkRemoveTasks(scheduler);
+                break;
+            case 10:
+                setTenantWeightMenu(scheduler);
+                break;
+            case 11:
+                importExportTasks(scheduler);
+                break;
+            case 12:
+                addSteppedTask(scheduler);
+                break;
+            case 13:
                 printf("\n  Exiting program...\n");
                 printf("  Cleaning up memory...\n");
-                if (scheduler->runningTask != NULL) {
-                    free(scheduler->runningTask);
-                }
-                freeQueue(&scheduler->readyQueue);
-                freePQ(&scheduler->priorityQueue);
-                freeHistory(&scheduler->history);
+                cleanupScheduler(scheduler);
                 printf("  All memory freed successfully!\n");
                 printf("  Goodbye!\n\n");
                 return;
             default:
-                printf("\n  Warning: Invalid choice! Please enter 1-8.\n");
+                printf("\n  Warning: Invalid choice! Please enter 1-13.\n");
         }
         
         printf("\n  Press Enter to continue...");
@@ -312,10 +1052,40 @@ void runScheduler(TaskScheduler* scheduler) {
 
 // Cleanup scheduler resources
 void cleanupScheduler(TaskScheduler* scheduler) {
+    // Return the stacks of unfinished coroutine tasks to the pool
+    for (QueueNode* node = scheduler->readyQueue.front; node != NULL; node = node->next) {
+        releaseCoroutine(&node->task);
+    }
+    for (int i = 0; i < scheduler->priorityQueue.size; i++) {
+        releaseCoroutine(scheduler->priorityQueue.heap[i]);
+    }
+    if (scheduler->priorityBackend == HEAP_PAIRING) {
+        // Pairing nodes are only reachable through the tree; the index lists them all
+        for (IndexNode* node = scheduler->index.head->links[0].next; node != NULL;
+             node = node->links[0].next) {
+            releaseCoroutine(node->task);
+        }
+    }
+    for (int i = 0; i < scheduler->fairQueue.activeCount; i++) {
+        Tenant* tenant = scheduler->fairQueue.active[i];
+        for (QueueNode* node = tenant->queue.front; node != NULL; node = node->next) {
+            releaseCoroutine(&node->task);
+        }
+    }
+    for (HistoryNode* node = scheduler->history.head; node != NULL; node = node->next) {
+        releaseCoroutine(&node->task);
+    }
+    
     if (scheduler->runningTask != NULL) {
+        releaseCoroutine(scheduler->runningTask);
         free(scheduler->runningTask);
+        scheduler->runningTask = NULL;
     }
     freeQueue(&scheduler->readyQueue);
     freePQ(&scheduler->priorityQueue);
+    freePairingHeap(&scheduler->pairingQueue);
+    freePairingHeap(&scheduler->pairingBacklog);
+    freeFairQueue(&scheduler->fairQueue);
     freeHistory(&scheduler->history);
+    freeOrderIndex(&scheduler->index);
 }
@@ -0,0 +1,449 @@
+#define _GNU_SOURCE
+#include "sharded_scheduler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <time.h>
+#include <sched.h>
+#include <unistd.h>
+
+#define REBALANCE_MIN_GAP 8
+#define MAX_MIGRATION_BATCH 1024
+#define SHARD_HISTORY_LIMIT 1024   // Workers finish tasks nonstop; older records only live on in stats
+#define FORWARD_MIN_BUCKETS 256
+
+// Operation on one shard's scheduler, as used by cancel, pause and resume
+typedef int (*ShardTaskOp)(TaskScheduler* scheduler, int id);
+
+// Publish the shard's queue length for lock-free placement decisions
+static void publishLoad(SchedulerShard* shard) {
+    __atomic_store_n(&shard->load, queuedCount(&shard->scheduler), __ATOMIC_RELAXED);
+}
+
+static int readLoad(const SchedulerShard* shard) {
+    return __atomic_load_n(&shard->load, __ATOMIC_RELAXED);
+}
+
+// Per-thread xorshift generator for placement choices
+static unsigned int nextRandom(void) {
+    static __thread unsigned int state = 0;
+    if (state == 0) {
+        state = (unsigned int)time(NULL) ^ (unsigned int)(size_t)&state;
+        if (state == 0) state = 1;
+    }
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+static void initForwardTable(ForwardTable* table, int shardCount) {
+    pthread_mutex_init(&table->lock, NULL);
+    table->bucketCount = FORWARD_MIN_BUCKETS;
+    table->buckets = (ForwardEntry**)calloc(table->bucketCount, sizeof(ForwardEntry*));
+    table->count = 0;
+    table->shardCount = shardCount;
+}
+
+// Double the bucket array once entries outnumber buckets - amortized O(1)
+static void growForwardTable(ForwardTable* table) {
+    int bucketCount = table->bucketCount * 2;
+    ForwardEntry** buckets = (ForwardEntry**)calloc(bucketCount, sizeof(ForwardEntry*));
+    for (int i = 0; i < table->bucketCount; i++) {
+        ForwardEntry* entry = table->buckets[i];
+        while (entry != NULL) {
+            ForwardEntry* next = entry->next;
+            unsigned int b = (unsigned int)entry->id % (unsigned int)bucketCount;
+            entry->next = buckets[b];
+            buckets[b] = entry;
+            entry = next;
+        }
+    }
+    free(table->buckets);
+    table->buckets = buckets;
+    table->bucketCount = bucketCount;
+}
+
+// Record that a task is now on the given shard; a task back on its home
+// shard needs no entry - Time Complexity: O(1) expected
+static void forwardTask(ForwardTable* table, int id, int shard) {
+    int home = id % table->shardCount;
+    pthread_mutex_lock(&table->lock);
+    ForwardEntry** link = &table->buckets[(unsigned int)id % (unsigned int)table->bucketCount];
+    while (*link != NULL && (*link)->id != id) link = &(*link)->next;
+
+    if (*link != NULL) {
+        if (shard == home) {
+            ForwardEntry* entry = *link;
+            *link = entry->next;
+            free(entry);
+            table->count--;
+        } else {
+            (*link)->shard = shard;
+        }
+    } else if (shard != home) {
+        ForwardEntry* entry = (ForwardEntry*)malloc(sizeof(ForwardEntry));
+        entry->id = id;
+        entry->shard = shard;
+        entry->next = NULL;
+        *link = entry;
+        if (++table->count > table->bucketCount) growForwardTable(table);
+    }
+    pthread_mutex_unlock(&table->lock);
+}
+
+// Forget a task that left a shard for good; tasks on their home shard have
+// no entry, so they cost nothing here
+static void forgetTask(ForwardTable* table, int id, int shard) {
+    if (id % table->shardCount != shard) forwardTask(table, id, id % table->shardCount);
+}
+
+// Shard a task was forwarded to, or its home shard - Time Complexity: O(1) expected
+static int lookupShard(ForwardTable* table, int id) {
+    int shard = id % table->shardCount;
+    pthread_mutex_lock(&table->lock);
+    ForwardEntry* entry = table->buckets[(unsigned int)id % (unsigned int)table->bucketCount];
+    while (entry != NULL && entry->id != id) entry = entry->next;
+    if (entry != NULL) shard = entry->shard;
+    pthread_mutex_unlock(&table->lock);
+    return shard;
+}
+
+static void freeForwardTable(ForwardTable* table) {
+    for (int i = 0; i < table->bucketCount; i++) {
+        ForwardEntry* entry = table->buckets[i];
+        while (entry != NULL) {
+            ForwardEntry* next = entry->next;
+            free(entry);
+            entry = next;
+        }
+    }
+    free(table->buckets);
+    table->buckets = NULL;
+    table->count = 0;
+    pthread_mutex_destroy(&table->lock);
+}
+
+// Initialize N independent scheduler instances
+void initShardedScheduler(ShardedScheduler* ss, int shardCount, SchedulingMode mode) {
+    if (shardCount < 1) shardCount = 1;
+    ss->shards = (SchedulerShard*)calloc(shardCount, sizeof(SchedulerShard));
+    ss->shardCount = shardCount;
+    ss->running = 0;
+    ss->rebalanceIntervalMs = 0;
+    initForwardTable(&ss->forward, shardCount);
+
+    long cores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (cores < 1) cores = 1;
+
+    for (int i = 0; i < shardCount; i++) {
+        SchedulerShard* shard = &ss->shards[i];
+        initScheduler(&shard->scheduler);
+        shard->scheduler.mode = mode;
+        shard->scheduler.history.limit = SHARD_HISTORY_LIMIT;
+        pthread_mutex_init(&shard->lock, NULL);
+        pthread_cond_init(&shard->workAvailable, NULL);
+        shard->index = i;
+        shard->core = (int)(i % cores);
+        shard->nextLocalId = 1;
+        shard->forward = &ss->forward;
+    }
+}
+
+// Worker loop: run queued tasks of one shard on its pinned core
+static void* shardWorker(void* arg) {
+    SchedulerShard* shard = (SchedulerShard*)arg;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(shard->core, &cpus);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+
+    pthread_mutex_lock(&shard->lock);
+    while (!shard->stopping) {
+        Task done;
+        if (!completeNextTask(&shard->scheduler, &done)) {
+            pthread_cond_wait(&shard->workAvailable, &shard->lock);
+            continue;
+        }
+        forgetTask(shard->forward, done.id, shard->index);
+        publishLoad(shard);
+
+        // Let submitters and the rebalancer in between tasks
+        pthread_mutex_unlock(&shard->lock);
+        pthread_mutex_lock(&shard->lock);
+    }
+    pthread_mutex_unlock(&shard->lock);
+    return NULL;
+}
+
+// Periodically even out queue lengths until the front end stops
+static void* rebalancerLoop(void* arg) {
+    ShardedScheduler* ss = (ShardedScheduler*)arg;
+    struct timespec slice = {0, 10 * 1000000L};
+    int waitedMs = 0;
+
+    while (__atomic_load_n(&ss->running, __ATOMIC_ACQUIRE)) {
+        nanosleep(&slice, NULL);
+        waitedMs += 10;
+        if (waitedMs >= ss->rebalanceIntervalMs) {
+            rebalanceShards(ss);
+            waitedMs = 0;
+        }
+    }
+    return NULL;
+}
+
+// Apply the same admission limits to every shard
+void configureShardAdmission(ShardedScheduler* ss, AdmissionConfig config) {
+    for (int i = 0; i < ss->shardCount; i++) {
+        SchedulerShard* shard = &ss->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        configureAdmission(&shard->scheduler, config);
+        pthread_mutex_unlock(&shard->lock);
+    }
+}
+
+// Start one pinned worker per shard, plus the rebalancer if an interval is given
+void startShardWorkers(ShardedScheduler* ss, int rebalanceIntervalMs) {
+    if (ss->running) return;
+    ss->running = 1;
+    ss->rebalanceIntervalMs = rebalanceIntervalMs;
+
+    for (int i = 0; i < ss->shardCount; i++) {
+        ss->shards[i].stopping = 0;
+        pthread_create(&ss->shards[i].worker, NULL, shardWorker, &ss->shards[i]);
+    }
+    if (rebalanceIntervalMs > 0) {
+        pthread_create(&ss->rebalancer, NULL, rebalancerLoop, ss);
+    }
+}
+
+// Stop and join all worker threads
+void stopShardWorkers(ShardedScheduler* ss) {
+    if (!ss->running) return;
+    __atomic_store_n(&ss->running, 0, __ATOMIC_RELEASE);
+    if (ss->rebalanceIntervalMs > 0) {
+        pthread_join(ss->rebalancer, NULL);
+    }
+
+    for (int i = 0; i < ss->shardCount; i++) {
+        SchedulerShard* shard = &ss->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        shard->stopping = 1;
+        pthread_cond_signal(&shard->workAvailable);
+        pthread_mutex_unlock(&shard->lock);
+        pthread_join(shard->worker, NULL);
+    }
+}
+
+// Next ID owned by a shard (id % shardCount == index). The local counter wraps
+// back to 1 before the ID would pass INT_MAX, and IDs still queued are skipped
+static int takeShardTaskId(ShardedScheduler* ss, SchedulerShard* shard) {
+    int lastLocalId = (INT_MAX - shard->index) / ss->shardCount;
+    for (;;) {
+        if (shard->nextLocalId > lastLocalId) shard->nextLocalId = 1;
+        int id = shard->nextLocalId++ * ss->shardCount + shard->index;
+        if (findInIndex(&shard->scheduler.index, id) == NULL) return id;
+    }
+}
+
+// Submit to a lightly loaded shard, chosen by power-of-two-choices - returns
+// the new task ID or a SUBMIT_* code; on SUBMIT_WOULD_BLOCK the caller retries
+// later and counts the wait itself
+int shardedSubmit(ShardedScheduler* ss, const char* name, int priority, int execTime) {
+    SchedulerShard* shard = &ss->shards[0];
+    if (ss->shardCount > 1) {
+        SchedulerShard* a = &ss->shards[nextRandom() % ss->shardCount];
+        SchedulerShard* b = &ss->shards[nextRandom() % ss->shardCount];
+        shard = readLoad(a) <= readLoad(b) ? a : b;
+    }
+
+    pthread_mutex_lock(&shard->lock);
+    // Eviction drops the lowest task, which may have migrated here
+    const IndexNode* lowest = shard->scheduler.index.tail;
+    int lowestId = lowest != NULL ? lowest->id : 0;
+    long evicted = shard->scheduler.stats.evicted;
+    int verdict = admitTask(&shard->scheduler, priority);
+    if (shard->scheduler.stats.evicted != evicted) forgetTask(&ss->forward, lowestId, shard->index);
+    if (verdict != 1) {
+        pthread_mutex_unlock(&shard->lock);
+        return verdict;
+    }
+
+    int id = takeShardTaskId(ss, shard);
+    enqueueTask(&shard->scheduler, createTask(id, name, priority, execTime));
+    shard->scheduler.stats.submitted++;
+    publishLoad(shard);
+    pthread_cond_signal(&shard->workAvailable);
+    pthread_mutex_unlock(&shard->lock);
+
+    return id;
+}
+
+// Run op on the shard holding a task: its home shard, or the one the
+// forwarding table names. A task that migrates again between the lookup and
+// taking the lock is followed to its new shard - returns op's result
+static int onHoldingShard(ShardedScheduler* ss, int id, ShardTaskOp op, int leavesShard) {
+    if (id <= 0) return 0;
+    int index = id % ss->shardCount;
+
+    for (;;) {
+        SchedulerShard* shard = &ss->shards[index];
+        pthread_mutex_lock(&shard->lock);
+        int found = op(&shard->scheduler, id);
+        if (found) {
+            if (leavesShard) forgetTask(&ss->forward, id, index);
+            publishLoad(shard);
+            pthread_cond_signal(&shard->workAvailable);
+        }
+        pthread_mutex_unlock(&shard->lock);
+        if (found) return 1;
+
+        // Migration updates the table before releasing the shard it took the task from
+        int next = lookupShard(&ss->forward, id);
+        if (next == index) return 0;
+        index = next;
+    }
+}
+
+// Cancel a queued task on the shard holding it
+int shardedCancel(ShardedScheduler* ss, int id) {
+    return onHoldingShard(ss, id, cancelTask, 1);
+}
+
+// Hold a queued task as PAUSED on the shard holding it; the paused record
+// stays there, so its forwarding entry is kept for the resume
+int shardedPause(ShardedScheduler* ss, int id) {
+    return onHoldingShard(ss, id, pauseTaskById, 0);
+}
+
+// Resume on the shard holding the paused record
+int shardedResume(ShardedScheduler* ss, int id) {
+    return onHoldingShard(ss, id, resumeTaskById, 0);
+}
+
+// Move queued work from the busiest to the idlest shard - returns tasks moved
+int rebalanceShards(ShardedScheduler* ss) {
+    if (ss->shardCount < 2) return 0;
+
+    SchedulerShard* busiest = &ss->shards[0];
+    SchedulerShard* idlest = &ss->shards[0];
+    for (int i = 1; i < ss->shardCount; i++) {
+        if (readLoad(&ss->shards[i]) > readLoad(busiest)) busiest = &ss->shards[i];
+        if (readLoad(&ss->shards[i]) < readLoad(idlest)) idlest = &ss->shards[i];
+    }
+
+    int gap = readLoad(busiest) - readLoad(idlest);
+    if (gap < REBALANCE_MIN_GAP) return 0;
+
+    // Lock both shards in index order; the forwarding table changes under both
+    // locks, so a lookup after missing on either shard sees where a task went
+    SchedulerShard* first = busiest->index < idlest->index ? busiest : idlest;
+    SchedulerShard* second = first == busiest ? idlest : busiest;
+    pthread_mutex_lock(&first->lock);
+    pthread_mutex_lock(&second->lock);
+
+    int toMove = (queuedCount(&busiest->scheduler) - queuedCount(&idlest->scheduler)) / 2;
+    if (toMove > MAX_MIGRATION_BATCH) toMove = MAX_MIGRATION_BATCH;
+    if (toMove < 0) toMove = 0;  // Loads moved on while the locks were taken
+
+    // Move the work the busy shard would reach last, oldest first so it keeps
+    // its relative order on the idle shard
+    Task* batch = (Task*)malloc(toMove * sizeof(Task));
+    int moved = 0;
+    while (moved < toMove && takeLeastUrgentTask(&busiest->scheduler, &batch[moved])) moved++;
+    for (int i = moved - 1; i >= 0; i--) {
+        enqueueTask(&idlest->scheduler, batch[i]);
+        forwardTask(&ss->forward, batch[i].id, idlest->index);
+    }
+    free(batch);
+    busiest->migratedOut += moved;
+    idlest->migratedIn += moved;
+    publishLoad(busiest);
+    publishLoad(idlest);
+    if (moved > 0) pthread_cond_signal(&idlest->workAvailable);
+
+    pthread_mutex_unlock(&second->lock);
+    pthread_mutex_unlock(&first->lock);
+    return moved;
+}
+
+// Merge per-shard counters, taking one shard lock at a time
+void shardedStats(ShardedScheduler* ss, SchedulerStats* total, int* queued) {
+    SchedulerStats sum = {0};
+    int queuedSum = 0;
+
+    for (int i = 0; i < ss->shardCount; i++) {
+        SchedulerShard* shard = &ss->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        sum.submitted += shard->scheduler.stats.submitted;
+        sum.completed += shard->scheduler.stats.completed;
+        sum.cancelled += shard->scheduler.stats.cancelled;
+        sum.resumed += shard->scheduler.stats.resumed;
+        sum.rejected += shard->scheduler.stats.rejected;
+        sum.blocked += shard->scheduler.stats.blocked;
+        sum.evicted += shard->scheduler.stats.evicted;
+        sum.shed += shard->scheduler.stats.shed;
+        queuedSum += queuedCount(&shard->scheduler);
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    if (total != NULL) *total = sum;
+    if (queued != NULL) *queued = queuedSum;
+}
+
+// qsort comparator: highest priority first, then by ID so copies of one task meet
+static int compareSnapshot(const void* a, const void* b) {
+    const Task* x = (const Task*)a;
+    const Task* y = (const Task*)b;
+    if (x->priority != y->priority) return x->priority > y->priority ? -1 : 1;
+    return (x->id > y->id) - (x->id < y->id);
+}
+
+// Copy every queued task of all shards into one list, highest priority first,
+// taking one shard lock at a time. A task migrating during the walk is listed
+// once even if both shards showed it, but may be missed if neither did.
+// Returns the count; the caller frees *out - Time Complexity: O(n log n)
+int snapshotShardedTasks(ShardedScheduler* ss, Task** out) {
+    Task* tasks = NULL;
+    int count = 0;
+    int capacity = 0;
+
+    for (int i = 0; i < ss->shardCount; i++) {
+        SchedulerShard* shard = &ss->shards[i];
+        pthread_mutex_lock(&shard->lock);
+        const OrderIndex* index = &shard->scheduler.index;
+        if (count + index->count > capacity) {
+            capacity = (count + index->count) * 2;
+            tasks = (Task*)realloc(tasks, capacity * sizeof(Task));
+        }
+        for (const IndexNode* node = index->head->links[0].next; node != NULL;
+             node = node->links[0].next) {
+            tasks[count++] = *node->task;
+        }
+        pthread_mutex_unlock(&shard->lock);
+    }
+
+    qsort(tasks, count, sizeof(Task), compareSnapshot);
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        if (kept == 0 || tasks[kept - 1].id != tasks[i].id) tasks[kept++] = tasks[i];
+    }
+    *out = tasks;
+    return kept;
+}
+
+// Stop workers and free every shard
+void cleanupShardedScheduler(ShardedScheduler* ss) {
+    stopShardWorkers(ss);
+    for (int i = 0; i < ss->shardCount; i++) {
+        cleanupScheduler(&ss->shards[i].scheduler);
+        pthread_mutex_destroy(&ss->shards[i].lock);
+        pthread_cond_destroy(&ss->shards[i].workAvailable);
+    }
+    free(ss->shards);
+    ss->shards = NULL;
+    freeForwardTable(&ss->forward);
+    ss->shardCount = 0;
+}
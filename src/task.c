@@ -9,6 +9,7 @@ const char* statusToString(TaskStatus status) {
         case PAUSED: return "PAUSED";
         case COMPLETED: return "COMPLETED";
         case REMOVED: return "REMOVED";
+        case RESUMED: return "RESUMED";
         default: return "UNKNOWN";
     }
 }
@@ -22,5 +23,9 @@ Task createTask(int id, const char* name, int priority, int execTime) {
     t.priority = priority;
     t.executionTime = execTime;
     t.status = READY;
+    t.tenant = 0;
+    t.seq = 0;
+    t.heapIndex = -1;
+    t.coroutine = NULL;
     return t;
 }
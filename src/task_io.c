@@ -0,0 +1,414 @@
+#include "task_io.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define CSV_HEADER "id,name,priority,executionTime,status,tenant\n"
+#define CSV_BUFFER_SIZE (1 << 16)
+#define CSV_MAX_LINE 512   // Longest formatted line: fully quoted name plus five numbers
+
+// Called once per task, in file order, by the export walk
+typedef void (*TaskSink)(const Task* task, void* ctx);
+
+#define LOAD_QUEUE_FULL -1
+
+// Queue length an import may fill up to: the high watermark when one is set,
+// since shedding above it needs priority checks a bulk load cannot make,
+// else the capacity - 0 means no limit
+static int importLimit(const TaskScheduler* scheduler) {
+    const AdmissionConfig* admission = &scheduler->admission;
+    return admission->highWatermark > 0 ? admission->highWatermark : admission->capacity;
+}
+
+// Hand one parsed task to the scheduler: queued states go through the bulk
+// load path, the rest straight into history - returns 0 if the ID is already
+// queued, including earlier in the same file, or LOAD_QUEUE_FULL once the
+// queue has reached the import limit
+static int loadTask(TaskScheduler* scheduler, Task* task) {
+    if (findInIndex(&scheduler->index, task->id) != NULL) return 0;
+    if (task->status == READY || task->status == RUNNING) {
+        int limit = importLimit(scheduler);
+        if (limit > 0 && scheduler->index.count + scheduler->index.stagedCount >= limit) {
+            return LOAD_QUEUE_FULL;
+        }
+        bulkLoadTask(scheduler, *task);
+    } else {
+        addToHistory(&scheduler->history, *task);
+        reserveTaskId(scheduler, task->id);
+    }
+    return 1;
+}
+
+// Read fixed records straight out of the mapping - Time Complexity: O(n log n)
+static long importBinary(TaskScheduler* scheduler, const char* data, size_t size, long* errorLine,
+                         int* full) {
+    const TaskFileHeader* header = (const TaskFileHeader*)data;
+    if (size < sizeof(TaskFileHeader) || header->recordSize != sizeof(TaskRecord) ||
+        header->count > (size - sizeof(TaskFileHeader)) / sizeof(TaskRecord)) {
+        return -1;
+    }
+
+    const TaskRecord* records = (const TaskRecord*)(data + sizeof(TaskFileHeader));
+    long loaded = 0;
+    for (uint64_t i = 0; i < header->count; i++) {
+        const TaskRecord* record = &records[i];
+        if (record->status < READY || record->status > RESUMED) {
+            if (errorLine != NULL) *errorLine = (long)i + 1;
+            break;
+        }
+        Task task = createTask(record->id, record->name, record->priority, record->executionTime);
+        task.status = (TaskStatus)record->status;
+        task.tenant = record->tenant;
+        int result = loadTask(scheduler, &task);
+        if (result == LOAD_QUEUE_FULL) {
+            if (full != NULL) *full = 1;
+            break;
+        }
+        loaded += result;
+    }
+    return loaded;
+}
+
+// Parse a decimal integer at the cursor without reading past end - returns 0 on failure
+static int csvInt(const char** cursor, const char* end, int* value) {
+    const char* p = *cursor;
+    int negative = p < end && *p == '-';
+    if (negative) p++;
+    if (p == end || *p < '0' || *p > '9') return 0;
+
+    long v = 0;
+    long maxMagnitude = negative ? (long)INT_MAX + 1 : INT_MAX;  // Admit INT_MIN
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        if (v > maxMagnitude) return 0;
+    }
+    *value = (int)(negative ? -v : v);
+    *cursor = p;
+    return 1;
+}
+
+// Consume the expected separator - returns 0 if it is not there
+static int csvExpect(const char** cursor, const char* end, char c) {
+    if (*cursor == end || **cursor != c) return 0;
+    (*cursor)++;
+    return 1;
+}
+
+// Copy a plain or double-quoted name field into the task, truncating to fit
+static int csvName(const char** cursor, const char* end, char* name) {
+    const char* p = *cursor;
+    int length = 0;
+
+    if (p < end && *p == '"') {
+        for (p++; ; p++) {
+            if (p == end) return 0;
+            if (*p == '"') {
+                if (p + 1 < end && p[1] == '"') {
+                    p++;  // Escaped quote
+                } else {
+                    p++;
+                    break;
+                }
+            }
+            if (length < TASK_RECORD_NAME - 1) name[length++] = *p;
+        }
+    } else {
+        for (; p < end && *p != ',' && *p != '\n' && *p != '\r'; p++) {
+            if (length < TASK_RECORD_NAME - 1) name[length++] = *p;
+        }
+    }
+    name[length] = '\0';
+    *cursor = p;
+    return 1;
+}
+
+// Match a status name such as READY or PAUSED
+static int csvStatus(const char** cursor, const char* end, TaskStatus* status) {
+    const char* p = *cursor;
+    while (p < end && *p != ',' && *p != '\n' && *p != '\r') p++;
+    size_t length = (size_t)(p - *cursor);
+
+    for (int s = READY; s <= RESUMED; s++) {
+        const char* text = statusToString((TaskStatus)s);
+        if (strlen(text) == length && memcmp(text, *cursor, length) == 0) {
+            *status = (TaskStatus)s;
+            *cursor = p;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+// Parse one line (tenant column optional) and its terminator into task
+static int csvTask(const char** cursor, const char* end, Task* task) {
+    const char* p = *cursor;
+    int id, priority, execTime, tenant = DEFAULT_TENANT;
+    TaskStatus status;
+    char name[TASK_RECORD_NAME];
+
+    if (!csvInt(&p, end, &id) || !csvExpect(&p, end, ',') ||
+        !csvName(&p, end, name) || !csvExpect(&p, end, ',') ||
+        !csvInt(&p, end, &priority) || !csvExpect(&p, end, ',') ||
+        !csvInt(&p, end, &execTime) || !csvExpect(&p, end, ',') ||
+        !csvStatus(&p, end, &status)) {
+        return 0;
+    }
+    if (p < end && *p == ',') {
+        p++;
+        if (!csvInt(&p, end, &tenant)) return 0;
+    }
+    if (p < end && *p == '\r') p++;
+    if (p < end && !csvExpect(&p, end, '\n')) return 0;
+
+    *task = createTask(id, name, priority, execTime);
+    task->status = status;
+    task->tenant = tenant;
+    *cursor = p;
+    return 1;
+}
+
+// Parse CSV lines directly from the mapping, stopping at the first bad line
+// Time Complexity: O(bytes + n log n)
+static long importCsv(TaskScheduler* scheduler, const char* data, size_t size, long* errorLine,
+                      int* full) {
+    const char* p = data;
+    const char* end = data + size;
+    long line = 0;
+    long loaded = 0;
+
+    while (p < end) {
+        line++;
+        if (*p == '\n' || *p == '\r' || (line == 1 && size >= 3 && memcmp(p, "id,", 3) == 0)) {
+            // Blank line or header
+            const char* newline = memchr(p, '\n', (size_t)(end - p));
+            p = newline != NULL ? newline + 1 : end;
+            continue;
+        }
+
+        Task task;
+        if (!csvTask(&p, end, &task)) {
+            if (errorLine != NULL) *errorLine = line;
+            break;
+        }
+        int result = loadTask(scheduler, &task);
+        if (result == LOAD_QUEUE_FULL) {
+            if (full != NULL) *full = 1;
+            break;
+        }
+        loaded += result;
+    }
+    return loaded;
+}
+
+// Load a binary or CSV task set (detected by its magic) into the scheduler.
+// Queued tasks keep their IDs; tasks whose ID is already queued, or repeats
+// one earlier in the file, are skipped. Returns the number loaded, or -1 if
+// the file cannot be read or has a bad header. A nonzero errorLine means
+// loading stopped at that line (CSV) or record (binary); full is set when it
+// stopped because the queue reached the admission limit (see importLimit).
+long importTasks(TaskScheduler* scheduler, const char* path, long* errorLine, int* full) {
+    if (errorLine != NULL) *errorLine = 0;
+    if (full != NULL) *full = 0;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return -1;
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -1;
+    }
+    size_t size = (size_t)info.st_size;
+    if (size == 0) {
+        close(fd);
+        return 0;
+    }
+
+    char* data = (char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    long loaded;
+    if (size >= sizeof(TaskFileHeader) && memcmp(data, TASK_FILE_MAGIC, 8) == 0) {
+        loaded = importBinary(scheduler, data, size, errorLine, full);
+    } else {
+        loaded = importCsv(scheduler, data, size, errorLine, full);
+    }
+    finishBulkLoad(scheduler);
+
+    munmap(data, size);
+    return loaded;
+}
+
+// Visit the running task, queued tasks in dispatch order, then history - Time Complexity: O(n)
+static void visitAllTasks(const TaskScheduler* scheduler, TaskSink sink, void* ctx) {
+    if (scheduler->runningTask != NULL) sink(scheduler->runningTask, ctx);
+
+    switch (scheduler->mode) {
+        case FIFO:
+            for (const QueueNode* node = scheduler->readyQueue.front; node != NULL; node = node->next) {
+                sink(&node->task, ctx);
+            }
+            break;
+        case FAIR_SHARE:
+            for (int i = 0; i < scheduler->fairQueue.activeCount; i++) {
+                const Tenant* tenant = scheduler->fairQueue.active[i];
+                for (const QueueNode* node = tenant->queue.front; node != NULL; node = node->next) {
+                    sink(&node->task, ctx);
+                }
+            }
+            break;
+        case PRIORITY:
+        default:
+            // The order index already holds the heap's tasks in extraction order
+            for (const IndexNode* node = scheduler->index.head->links[0].next; node != NULL;
+                 node = node->links[0].next) {
+                sink(node->task, ctx);
+            }
+            break;
+    }
+
+    for (const HistoryNode* node = scheduler->history.head; node != NULL; node = node->next) {
+        sink(&node->task, ctx);
+    }
+}
+
+// Write one task as a record in the mapped output file
+static void writeRecord(const Task* task, void* ctx) {
+    TaskRecord** next = (TaskRecord**)ctx;
+    TaskRecord* record = (*next)++;
+    record->id = task->id;
+    record->priority = task->priority;
+    record->executionTime = task->executionTime;
+    record->status = task->status;
+    record->tenant = task->tenant;
+    strncpy(record->name, task->name, TASK_RECORD_NAME);  // NUL-pads the rest
+}
+
+// Size the file once, map it and fill the records in place - Time Complexity: O(n)
+static long exportBinary(const TaskScheduler* scheduler, const char* path) {
+    long count = (scheduler->runningTask != NULL) + queuedCount(scheduler) + scheduler->history.count;
+    size_t size = sizeof(TaskFileHeader) + (size_t)count * sizeof(TaskRecord);
+
+    int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return -1;
+    if (ftruncate(fd, (off_t)size) != 0) {
+        close(fd);
+        return -1;
+    }
+    char* data = (char*)mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return -1;
+
+    TaskFileHeader* header = (TaskFileHeader*)data;
+    memcpy(header->magic, TASK_FILE_MAGIC, 8);
+    header->recordSize = sizeof(TaskRecord);
+    header->reserved = 0;
+    header->count = (uint64_t)count;
+
+    TaskRecord* next = (TaskRecord*)(data + sizeof(TaskFileHeader));
+    visitAllTasks(scheduler, writeRecord, &next);
+
+    munmap(data, size);
+    return count;
+}
+
+// Output buffer for CSV export, flushed with write() as it fills
+typedef struct {
+    int fd;
+    char buffer[CSV_BUFFER_SIZE];
+    size_t used;
+    int failed;
+    long written;
+} CsvWriter;
+
+static void csvFlush(CsvWriter* writer) {
+    size_t done = 0;
+    while (done < writer->used && !writer->failed) {
+        ssize_t n = write(writer->fd, writer->buffer + done, writer->used - done);
+        if (n <= 0) writer->failed = 1;
+        else done += (size_t)n;
+    }
+    writer->used = 0;
+}
+
+static void csvPutInt(CsvWriter* writer, int value) {
+    char digits[12];
+    int n = 0;
+    unsigned int v = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v > 0);
+    if (value < 0) writer->buffer[writer->used++] = '-';
+    while (n > 0) writer->buffer[writer->used++] = digits[--n];
+}
+
+// Append one task as a CSV line, quoting the name only when it needs it
+static void writeCsvLine(const Task* task, void* ctx) {
+    CsvWriter* writer = (CsvWriter*)ctx;
+    if (writer->used > CSV_BUFFER_SIZE - CSV_MAX_LINE) csvFlush(writer);
+
+    csvPutInt(writer, task->id);
+    writer->buffer[writer->used++] = ',';
+    if (strpbrk(task->name, ",\"\r\n") != NULL) {
+        writer->buffer[writer->used++] = '"';
+        for (const char* c = task->name; *c != '\0'; c++) {
+            if (*c == '"') writer->buffer[writer->used++] = '"';
+            writer->buffer[writer->used++] = *c;
+        }
+        writer->buffer[writer->used++] = '"';
+    } else {
+        size_t length = strlen(task->name);
+        memcpy(writer->buffer + writer->used, task->name, length);
+        writer->used += length;
+    }
+    writer->buffer[writer->used++] = ',';
+    csvPutInt(writer, task->priority);
+    writer->buffer[writer->used++] = ',';
+    csvPutInt(writer, task->executionTime);
+    writer->buffer[writer->used++] = ',';
+    const char* status = statusToString(task->status);
+    size_t length = strlen(status);
+    memcpy(writer->buffer + writer->used, status, length);
+    writer->used += length;
+    writer->buffer[writer->used++] = ',';
+    csvPutInt(writer, task->tenant);
+    writer->buffer[writer->used++] = '\n';
+    writer->written++;
+}
+
+// Stream CSV lines through a fixed buffer; the final size is not known up front
+// Time Complexity: O(n)
+static long exportCsv(const TaskScheduler* scheduler, const char* path) {
+    CsvWriter* writer = (CsvWriter*)malloc(sizeof(CsvWriter));
+    writer->fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (writer->fd < 0) {
+        free(writer);
+        return -1;
+    }
+    writer->used = strlen(CSV_HEADER);
+    memcpy(writer->buffer, CSV_HEADER, writer->used);
+    writer->failed = 0;
+    writer->written = 0;
+
+    visitAllTasks(scheduler, writeCsvLine, writer);
+    csvFlush(writer);
+
+    long written = writer->failed ? -1 : writer->written;
+    close(writer->fd);
+    free(writer);
+    return written;
+}
+
+// Write the running task, every queued task and the whole history to path -
+// returns the number of tasks written or -1 on an I/O error
+long exportTasks(const TaskScheduler* scheduler, const char* path, TaskFileFormat format) {
+    return format == TASKFILE_CSV ? exportCsv(scheduler, path) : exportBinary(scheduler, path);
+}